@@ -2,7 +2,6 @@ TEMPLATE = app
 TARGET = delia_gui
 INCLUDEPATH += .
 INCLUDEPATH += delia_common/include
-INCLUDEPATH += thirdparty/AudioFile
 QT += gui widgets
 
 # You can make your code fail to compile if you use deprecated APIs.
@@ -24,24 +23,33 @@ INCLUDEPATH += src/widgets
 HEADERS += src/main_window.h
 HEADERS += src/gui_msg_thread.h
 HEADERS += src/timer.h
+HEADERS += src/frame_scheduler.h
 HEADERS += src/gui_common.h
 HEADERS += src/sound_scope_msg_thread.h
 HEADERS += src/utils.h
+HEADERS += src/text_elider.h
+HEADERS += src/param_layout.h
+HEADERS += src/screen_layout.h
+HEADERS += src/style_registry.h
 HEADERS += src/widgets/background.h
 HEADERS += src/widgets/bottom_bar.h
 HEADERS += src/widgets/chart.h
 HEADERS += src/widgets/vcf_cutoff_chart.h
+HEADERS += src/widgets/dseg7_glyph_atlas.h
 HEADERS += src/widgets/edit_name.h
 HEADERS += src/widgets/eg_chart.h
+HEADERS += src/widgets/list_row.h
 HEADERS += src/widgets/main_list.h
 HEADERS += src/widgets/moniq_label.h
 HEADERS += src/widgets/msg_box.h
 HEADERS += src/widgets/msg_popup.h
 HEADERS += src/widgets/multi_status_bar.h
+HEADERS += src/widgets/param_value.h
 HEADERS += src/widgets/param_value_bar.h
 HEADERS += src/widgets/scope.h
 HEADERS += src/widgets/status_bar.h
 HEADERS += src/widgets/sound_scope.h
+HEADERS += src/widgets/wav_reader.h
 HEADERS += src/widgets/wt_file.h
 HEADERS += src/widgets/wt_scope.h
 HEADERS += include/version.h
@@ -49,23 +57,31 @@ SOURCES += src/main.cpp
 SOURCES += src/main_window.cpp
 SOURCES += src/gui_msg_thread.cpp
 SOURCES += src/timer.cpp
+SOURCES += src/frame_scheduler.cpp
 SOURCES += src/sound_scope_msg_thread.cpp
 SOURCES += src/utils.cpp
+SOURCES += src/text_elider.cpp
+SOURCES += src/param_layout.cpp
+SOURCES += src/style_registry.cpp
 SOURCES += src/widgets/background.cpp
 SOURCES += src/widgets/bottom_bar.cpp
 SOURCES += src/widgets/chart.cpp
 SOURCES += src/widgets/vcf_cutoff_chart.cpp
+SOURCES += src/widgets/dseg7_glyph_atlas.cpp
 SOURCES += src/widgets/edit_name.cpp
 SOURCES += src/widgets/eg_chart.cpp
+SOURCES += src/widgets/list_row.cpp
 SOURCES += src/widgets/main_list.cpp
 SOURCES += src/widgets/moniq_label.cpp
 SOURCES += src/widgets/msg_box.cpp
 SOURCES += src/widgets/msg_popup.cpp
 SOURCES += src/widgets/multi_status_bar.cpp
+SOURCES += src/widgets/param_value.cpp
 SOURCES += src/widgets/param_value_bar.cpp
 SOURCES += src/widgets/scope.cpp
 SOURCES += src/widgets/sound_scope.cpp
 SOURCES += src/widgets/status_bar.cpp
+SOURCES += src/widgets/wav_reader.cpp
 SOURCES += src/widgets/wt_file.cpp
 SOURCES += src/widgets/wt_scope.cpp
 LIBS += -lrt
@@ -0,0 +1,80 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  frame_scheduler.cpp
+ * @brief Frame Scheduler implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <algorithm>
+#include <QElapsedTimer>
+#include "frame_scheduler.h"
+
+// Constants
+constexpr int FRAME_INTERVAL_MS = 16;
+
+//----------------------------------------------------------------------------
+// FrameScheduler
+//----------------------------------------------------------------------------
+FrameScheduler::FrameScheduler(uint frame_budget_us, QObject *parent) : QObject(parent)
+{
+    // Initialise the class data
+    _frame_budget_us = frame_budget_us;
+    _timer.setInterval(FRAME_INTERVAL_MS);
+    connect(&_timer, &QTimer::timeout, this, &FrameScheduler::_run_frame);
+}
+
+//----------------------------------------------------------------------------
+// schedule
+//----------------------------------------------------------------------------
+void FrameScheduler::schedule(const void *owner, Task task)
+{
+    // Any pending task for this owner is replaced by the new task
+    cancel(owner);
+    _tasks.push_back({owner, task});
+
+    // Start running the tasks from the next frame
+    if (!_timer.isActive()) {
+        _timer.start();
+    }
+}
+
+//----------------------------------------------------------------------------
+// cancel
+//----------------------------------------------------------------------------
+void FrameScheduler::cancel(const void *owner)
+{
+    // Remove any pending task for this owner
+    _tasks.erase(std::remove_if(_tasks.begin(), _tasks.end(), 
+                                [owner](const PendingTask& t) { return t.owner == owner; }),
+                 _tasks.end());
+    if (_tasks.empty()) {
+        _timer.stop();
+    }
+}
+
+//----------------------------------------------------------------------------
+// _run_frame
+//----------------------------------------------------------------------------
+void FrameScheduler::_run_frame()
+{
+    QElapsedTimer elapsed;
+
+    // Run the pending tasks, in order, until the frame budget is used
+    // Note: At least one step is always run so that tasks always progress
+    elapsed.start();
+    while (!_tasks.empty()) {
+        // Run the next step of the oldest task, and remove it if complete
+        if (_tasks.front().task()) {
+            _tasks.pop_front();
+        }
+        if (elapsed.nsecsElapsed() >= ((qint64)_frame_budget_us * 1000)) {
+            break;
+        }
+    }
+
+    // Stop the frame timer if there is no more work to do
+    if (_tasks.empty()) {
+        _timer.stop();
+    }
+}
@@ -0,0 +1,54 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  frame_scheduler.h
+ * @brief Frame Scheduler class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _FRAME_SCHEDULER_H
+#define _FRAME_SCHEDULER_H
+
+#include <deque>
+#include <functional>
+#include <QObject>
+#include <QTimer>
+
+// Frame Scheduler class
+// Runs deferred GUI thread work in slices, limited to a time budget per frame,
+// so that long operations do not stall the scopes and animations. Each task is
+// called repeatedly until it returns true to indicate it is complete.
+// Note: A task must not schedule or cancel tasks itself
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    // Task function - does one step of work, and returns true when complete
+    typedef std::function<bool()> Task;
+
+    // Constructor
+    FrameScheduler(uint frame_budget_us, QObject *parent = nullptr);
+
+    // Public functions
+    void schedule(const void *owner, Task task);
+    void cancel(const void *owner);
+
+private slots:
+    // Private slot functions
+    void _run_frame();
+
+private:
+    // Pending task
+    struct PendingTask
+    {
+        const void *owner;
+        Task task;
+    };
+
+    // Private data
+    QTimer _timer;
+    uint _frame_budget_us;
+    std::deque<PendingTask> _tasks;
+};
+
+#endif  // _FRAME_SCHEDULER_H
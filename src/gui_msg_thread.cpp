@@ -111,7 +111,9 @@ void GuiMsgThread::run()
                     break;
                 
                 case GuiMsgType::SHOW_NORMAL_PARAM:
-                    emit param_update_msg(msg.show_normal_param);
+                    // Lay out the param screen here, so that the GUI thread only
+                    // has to apply the layout
+                    emit param_update_msg(msg.show_normal_param, _param_layout_engine.layout(msg.show_normal_param));
                     break;
 
                 case GuiMsgType::SHOW_ADSR_ENV_PARAM:
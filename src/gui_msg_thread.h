@@ -13,6 +13,7 @@
 #include <QThread>
 #include "gui_msg.h"
 #include "gui_common.h"
+#include "param_layout.h"
 
 // GUI Message Thread class
 class GuiMsgThread : public QThread
@@ -34,7 +35,7 @@ signals:
     void select_layer_name_msg(const SelectLayerNameMsg& msg);
     void soft_buttons_text_msg(const SetSoftButtonsTextMsg& msg);
     void soft_buttons_state_msg(const SetSoftButtonsStateMsg& msg);
-    void param_update_msg(const ShowNormalParamMsg& msg);
+    void param_update_msg(const ShowNormalParamMsg& msg, ParamLayoutPtr layout);
     void param_value_update_msg(const ShowNormalParamUpdateMsg& msg);
     void enum_param_update_msg(const ShowEnumParamUpdateMsg& msg);
     void enum_param_value_update_msg(const ListSelectItemMsg& msg);
@@ -53,6 +54,7 @@ signals:
 
 private:
     std::atomic<bool> _exit_gui_msgs_thread;
+    ParamLayoutEngine _param_layout_engine;
 };
 
 #endif
@@ -6,79 +6,43 @@
  * @brief Main Window class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <algorithm>
 #include <QCoreApplication>
-#include <QFontDatabase>
 #include <QPainter>
 #include <unistd.h>
 #include <filesystem>
+#include <functional>
+#include <string_view>
 #include "main_window.h"
 #include "gui_common.h"
+#include "screen_layout.h"
+#include "text_elider.h"
+#include "style_registry.h"
 #include "utils.h"
 #include "version.h"
 
 // Constants
-constexpr uint VISIBLE_LCD_MARGIN_LEFT      = 9;
-constexpr uint VISIBLE_LCD_MARGIN_RIGHT     = 1;
-constexpr uint VISIBLE_LCD_WIDTH            = (LCD_WIDTH - VISIBLE_LCD_MARGIN_LEFT - VISIBLE_LCD_MARGIN_RIGHT);
-constexpr uint VISIBLE_LCD_MARGIN_TOP       = 5;
-constexpr uint VISIBLE_LCD_MARGIN_BOTTOM    = 5;
-constexpr uint VISIBLE_LCD_HEIGHT           = (LCD_HEIGHT - VISIBLE_LCD_MARGIN_TOP - VISIBLE_LCD_MARGIN_BOTTOM);
-constexpr uint STATUS_BAR_MARGIN_LEFT       = VISIBLE_LCD_MARGIN_LEFT;
-constexpr uint STATUS_BAR_MARGIN_TOP        = VISIBLE_LCD_MARGIN_TOP;
-constexpr uint STATUS_BAR_WIDTH             = VISIBLE_LCD_WIDTH;
-constexpr uint STATUS_BAR_HEIGHT            = 60;
-constexpr uint MULTI_STATUS_BAR_MARGIN_LEFT = VISIBLE_LCD_MARGIN_LEFT;
-constexpr uint MULTI_STATUS_BAR_MARGIN_TOP  = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 3);
-constexpr uint MULTI_STATUS_BAR_WIDTH       = VISIBLE_LCD_WIDTH;
-constexpr uint MULTI_STATUS_BAR_HEIGHT      = 46;
-constexpr uint MAIN_AREA_MARGIN_LEFT        = VISIBLE_LCD_MARGIN_LEFT;
-constexpr uint MAIN_AREA_MARGIN_TOP         = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT);
-constexpr uint MAIN_AREA_WIDTH              = VISIBLE_LCD_WIDTH;
-constexpr uint MAIN_AREA_HEIGHT             = 338;
-constexpr uint BOTTOM_BAR_MARGIN_LEFT       = VISIBLE_LCD_MARGIN_LEFT;
-constexpr uint BOTTOM_BAR_MARGIN_TOP        = (MAIN_AREA_MARGIN_TOP + MAIN_AREA_HEIGHT);
-constexpr uint BOTTOM_BAR_WIDTH             = VISIBLE_LCD_WIDTH;
-constexpr uint BOTTOM_BAR_HEIGHT            = (VISIBLE_LCD_HEIGHT - BOTTOM_BAR_MARGIN_TOP);
-constexpr uint LIST_MARGIN_LEFT             = VISIBLE_LCD_MARGIN_LEFT;
-constexpr uint LIST_MARGIN_TOP              = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 1);
-constexpr uint LIST_WIDTH                   = VISIBLE_LCD_WIDTH;
-constexpr uint LIST_ROW_HEIGHT              = 48;
-constexpr uint NUM_LIST_ROWS                = 7;
-constexpr uint LIST_HEIGHT                  = (7 * LIST_ROW_HEIGHT);
-constexpr uint LIST_FONT_SIZE               = 30;
-constexpr uint PARAM_LIST_MARGIN_TOP        = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 3);
-constexpr uint PARAM_LIST_WIDTH             = (VISIBLE_LCD_WIDTH/2);
-constexpr uint PARAM_VALUE_MARGIN_LEFT      = 10;
-constexpr uint PARAM_VALUE_MARGIN_LEFT_RLO  = (VISIBLE_LCD_MARGIN_LEFT + 10);
-constexpr uint PARAM_VALUE_MARGIN_RIGHT     = PARAM_LIST_WIDTH + 10;
-constexpr uint PARAM_VALUE_MARGIN_RIGHT_RLO = 10;
-constexpr uint PARAM_VALUE_WIDTH            = (VISIBLE_LCD_WIDTH - PARAM_VALUE_MARGIN_RIGHT - PARAM_VALUE_MARGIN_LEFT);
-constexpr uint PARAM_VALUE_NUM_FONT_SIZE    = 80;
-constexpr uint PARAM_VALUE_TXT_FONT_SIZE    = 36;
-constexpr uint PARAM_VALUE_TAG_FONT_SIZE    = 30;
-constexpr uint WT_LIST_WIDTH                = (VISIBLE_LCD_WIDTH/2);
-constexpr uint WT_CHART_MARGIN_LEFT         = (LIST_MARGIN_LEFT + WT_LIST_WIDTH + 10);
-constexpr uint WT_CHART_MARGIN_TOP          = (LIST_MARGIN_TOP + 10);
-constexpr uint WT_CHART_WIDTH               = (VISIBLE_LCD_WIDTH - WT_LIST_WIDTH - 20);
-constexpr uint WT_CHART_HEIGHT              = LIST_HEIGHT - 20;
-constexpr uint EG_STD_MARGIN_LEFT           = (VISIBLE_LCD_WIDTH - 600) / 2 ;
-constexpr uint EG_STD_MARGIN_TOP            = MULTI_STATUS_BAR_MARGIN_TOP + MULTI_STATUS_BAR_HEIGHT + 10;
-constexpr uint EG_STD_WIDTH                 = 600;
-constexpr uint EG_STD_HEIGHT                = MAIN_AREA_HEIGHT - MULTI_STATUS_BAR_HEIGHT - 20;
-constexpr uint EG_LST_MARGIN_LEFT           = (LIST_MARGIN_LEFT + PARAM_LIST_WIDTH + 10);
-constexpr uint EG_LST_MARGIN_TOP            = LIST_MARGIN_TOP + 10;
-constexpr uint EG_LST_WIDTH                 = (VISIBLE_LCD_WIDTH - PARAM_LIST_WIDTH - 20);
-constexpr uint EG_LST_HEIGHT                = (LIST_HEIGHT / 2) - 20;
-constexpr uint VCF_CUTOFF_MARGIN_LEFT       = (LIST_MARGIN_LEFT + PARAM_LIST_WIDTH + 10);
-constexpr uint VCF_CUTOFF_MARGIN_TOP        = LIST_MARGIN_TOP + 10;
-constexpr uint VCF_CUTOFF_WIDTH             = (VISIBLE_LCD_WIDTH - PARAM_LIST_WIDTH - 20);
-constexpr uint VCF_CUTOFF_HEIGHT            = LIST_HEIGHT - 20;
-constexpr uint SOUND_SCOPE_MARGIN_TOP       = (MAIN_AREA_MARGIN_TOP + 15);
-constexpr uint SOUND_SCOPE_HEIGHT           = (MAIN_AREA_HEIGHT - 15);
-constexpr uint OSC_SOUND_SCOPE_WIDTH        = VISIBLE_LCD_WIDTH;
-constexpr uint XY_SOUND_SCOPE_WIDTH         = SOUND_SCOPE_HEIGHT;
-constexpr uint OSC_SOUND_SCOPE_MARGIN_LEFT  = MAIN_AREA_MARGIN_LEFT;
-constexpr uint XY_SOUND_SCOPE_MARGIN_LEFT   = MAIN_AREA_MARGIN_LEFT + ((VISIBLE_LCD_WIDTH - XY_SOUND_SCOPE_WIDTH) / 2);
+constexpr uint FRAME_BUDGET_US       = 4000;
+constexpr uint ENUM_LIST_TEXT_MARGIN = 30;
+
+//----------------------------------------------------------------------------
+// _hash_list_items
+//----------------------------------------------------------------------------
+template<typename ListMsg>
+static std::size_t _hash_list_items(const ListMsg& msg)
+{
+    std::hash<std::string_view> hasher;
+
+    // Hash each item text - this is used as the list model cache key, so a
+    // list is only rebuilt if its content has changed
+    // Note: The list type is not hashed, as the main list, the enum param list
+    // and the WT enum param list each keep their own model cache
+    std::size_t hash = msg.num_items;
+    for (uint i=0; i<msg.num_items; i++) {
+        hash ^= hasher(msg.list_items[i]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
 
 //----------------------------------------------------------------------------
 // MainWindow
@@ -109,10 +73,14 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     qRegisterMetaType<ShowAdsrEnvParamUpdateMsg>();
     qRegisterMetaType<ShowVcfCutoffParamMsg>();
     qRegisterMetaType<ShowVcfCutoffParamUpdateMsg>();
+    qRegisterMetaType<ParamLayoutPtr>();
+
+    // Add the Melbourne Instruments specific fonts, and create the shared
+    // styles
+    style_registry::init();
 
-    // Add the Melbourne Instruments specific fonts
-    QFontDatabase::addApplicationFont(OCR_B_FONT_RES);
-    QFontDatabase::addApplicationFont(DSEG7_CLASSIC_FONT_RES);
+    // Create the scheduler for deferred GUI work
+    _frame_scheduler = new FrameScheduler(FRAME_BUDGET_US, this);
 
     // Create the GUI objects
     _create_gui_objs();
@@ -136,7 +104,7 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     connect(_gui_msg_thread, SIGNAL(select_layer_name_msg(SelectLayerNameMsg)), this, SLOT(select_layer_name(SelectLayerNameMsg)));
     connect(_gui_msg_thread, SIGNAL(soft_buttons_text_msg(SetSoftButtonsTextMsg)), this, SLOT(set_soft_buttons_text(SetSoftButtonsTextMsg)));
     connect(_gui_msg_thread, SIGNAL(soft_buttons_state_msg(SetSoftButtonsStateMsg)), this, SLOT(set_soft_buttons_state(SetSoftButtonsStateMsg)));
-    connect(_gui_msg_thread, SIGNAL(param_update_msg(ShowNormalParamMsg)), this, SLOT(process_param_update(ShowNormalParamMsg)));
+    connect(_gui_msg_thread, SIGNAL(param_update_msg(ShowNormalParamMsg,ParamLayoutPtr)), this, SLOT(process_param_update(ShowNormalParamMsg,ParamLayoutPtr)));
     connect(_gui_msg_thread, SIGNAL(param_value_update_msg(ShowNormalParamUpdateMsg)), this, SLOT(process_param_value_update(ShowNormalParamUpdateMsg)));
     connect(_gui_msg_thread, SIGNAL(enum_param_update_msg(ShowEnumParamUpdateMsg)), this, SLOT(process_enum_param_update(ShowEnumParamUpdateMsg)));
     connect(_gui_msg_thread, SIGNAL(enum_param_value_update_msg(ListSelectItemMsg)), this, SLOT(process_enum_param_value_update(ListSelectItemMsg)));
@@ -240,14 +208,12 @@ void MainWindow::show_list_items(const ShowListItemsMsg& msg)
 {
     // If any list items are specified
     if (msg.num_items > 0) {
-        // Delete and re-create the main list - we need to do this due to *NUMEROUS* issues with
-        // QT and re-assigning a list
-        delete _main_list;
-        _main_list = new MainList(NUM_LIST_ROWS, this);    
-        _main_list->setGeometry (LIST_MARGIN_LEFT, LIST_MARGIN_TOP, LIST_WIDTH, LIST_HEIGHT);
-        _main_list->stackUnder(_bottom_bar);
-
-        // Add items to the list
+        // Build the list items
+        // Note: The list item texts identify the list, so the main list can re-use
+        // the cached rows of a recently shown list, and only update the rows whose
+        // state has changed since it was last shown
+        std::vector<MainListItem> items;
+        items.reserve(msg.num_items);
         for (uint i=0; i<msg.num_items; i++) {
             // Special case!
             if (std::strcmp(msg.list_items[i], "GUI_VER") == 0) {
@@ -256,17 +222,13 @@ void MainWindow::show_list_items(const ShowListItemsMsg& msg)
                                                                      MONIQUE_GUI_GIT_COMMIT_HASH[0], MONIQUE_GUI_GIT_COMMIT_HASH[1], MONIQUE_GUI_GIT_COMMIT_HASH[2],
                                                                      MONIQUE_GUI_GIT_COMMIT_HASH[3], MONIQUE_GUI_GIT_COMMIT_HASH[4], MONIQUE_GUI_GIT_COMMIT_HASH[5],
                                                                      MONIQUE_GUI_GIT_COMMIT_HASH[6]);                
-                _main_list->add_item(sw_ver, false, true, false);
+                items.push_back({sw_ver, true, false});
             }
             else {
-                !msg.process_enabled_state ?
-                    _main_list->add_item(msg.list_items[i], (i == msg.selected_item), true, msg.list_item_separator[i]) :
-                    _main_list->add_item(msg.list_items[i], (i == msg.selected_item), msg.list_item_enabled[i], msg.list_item_separator[i]);
+                items.push_back({msg.list_items[i], (!msg.process_enabled_state || msg.list_item_enabled[i]), msg.list_item_separator[i]});
             }
         }
-        if (msg.selected_item != -1) {
-            _main_list->select_item(msg.selected_item);
-        }
+        _main_list->set_items(items, msg.selected_item, _hash_list_items(msg));
 
         // Show the list
         _main_list->show();
@@ -327,7 +289,7 @@ void MainWindow::set_soft_buttons_state(const SetSoftButtonsStateMsg& msg)
 //----------------------------------------------------------------------------
 // process_param_update
 //----------------------------------------------------------------------------
-void MainWindow::process_param_update(const ShowNormalParamMsg& msg)
+void MainWindow::process_param_update(const ShowNormalParamMsg& msg, ParamLayoutPtr layout)
 {
     bool show_background = false;
 
@@ -359,10 +321,7 @@ void MainWindow::process_param_update(const ShowNormalParamMsg& msg)
             _show_enum_param_list_obj(false);
         }
         _show_param_obj(false);
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
+        _clear_params_list();
         _multi_status_bar->hide();
         show_background = true;
     }
@@ -371,75 +330,26 @@ void MainWindow::process_param_update(const ShowNormalParamMsg& msg)
         _status_bar->set_left_status(msg.name);
 
         // Show the multi status bar if the sound names have been specified
-        uint list_margin_top = PARAM_LIST_MARGIN_TOP;
-        uint list_height = LIST_HEIGHT;
-        uint param_y_adj = 0;
-        if ((std::strlen(msg.l1_patch_name) > 0) && (std::strlen(msg.l2_patch_name) > 0)) {
-            // Show the multi status bar
+        // Note: The layout of the param screen has already been calculated by
+        // the GUI message thread, so it just needs to be applied here
+        if (layout->show_multi_status_bar) {
             _multi_status_bar->set_l1_sound_name(msg.l1_patch_name);
             _multi_status_bar->set_l2_sound_name(msg.l2_patch_name);
             _multi_status_bar->show();
-
-            // Adjust the param list and value for this bar
-            list_margin_top += MULTI_STATUS_BAR_HEIGHT + 2;
-            list_height -= MULTI_STATUS_BAR_HEIGHT + 2;
-            param_y_adj = MULTI_STATUS_BAR_HEIGHT + 2;
         }
         else {
             // Hide the multi-status bar
             _multi_status_bar->hide();
         }
 
-        // Was a display string specified? If so - show this as the value
-        QString str = "";
-        if (std::strlen(msg.display_string) > 0) {
-            // Show the param value as a text string
-            str = msg.display_string;
-            _param_value->setFont(QFont(STANDARD_FONT_NAME, PARAM_VALUE_TXT_FONT_SIZE));
-            _param_value->setText(str);              
-        }
-        else {
-            // Show the param value as a numerical value
-            str = msg.value_string;
-            _param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-            _param_value->setText(str);
-        }
-        _param_value->adjustSize();
+        // Set the value and its geometry
+        _param_value->set_layout(layout->value);
+        _param_value->setGeometry(layout->value_rect);
 
-        // Set the value geometry
-        uint width = _param_value->width();
-        while (width > PARAM_VALUE_WIDTH) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            _param_value->setText(trunc_str);
-            _param_value->adjustSize();
-            width = _param_value->width();
-        }
-        int x = msg.screen_orientation == ScreenOrientation::LEFT_RIGHT ?
-                    (VISIBLE_LCD_WIDTH - width - PARAM_VALUE_MARGIN_LEFT) :
-                    PARAM_VALUE_MARGIN_LEFT_RLO;
-        int y = list_margin_top + ((list_height - _param_value->height()) / 2);
-        _param_value->setGeometry (x, y, width, _param_value->height());
-
-        if (std::strlen(msg.value_tag) > 0) {
-            str = msg.value_tag;
-            _param_value_tag->setText(msg.value_tag);
-            _param_value_tag->adjustSize();
-            uint width = _param_value_tag->width();
-            while (width > PARAM_VALUE_WIDTH) {
-                str = str.mid(0, str.size() - 1);
-                QString trunc_str = str + "~";
-                _param_value_tag->setText(trunc_str);
-                _param_value_tag->adjustSize();
-                width = _param_value_tag->width();
-            }
-            x = msg.screen_orientation == ScreenOrientation::LEFT_RIGHT ?
-                    (VISIBLE_LCD_WIDTH - _param_value_tag->width() - 20) :        
-                    (_param_value_tag->width() < _param_value->width()) ?
-                        (PARAM_VALUE_MARGIN_LEFT_RLO + _param_value->width() - _param_value_tag->width()) :
-                        PARAM_VALUE_MARGIN_LEFT_RLO;
-            y += _param_value->height() + 10;
-            _param_value_tag->setGeometry (x, y, _param_value_tag->width(), _param_value_tag->height());
+        // Set the value tag and its geometry
+        if (layout->show_tag) {
+            _param_value_tag->setText(layout->tag_text);
+            _param_value_tag->setGeometry(layout->tag_rect);
             _param_value_tag->setVisible(true);  
         }
         else {
@@ -447,41 +357,20 @@ void MainWindow::process_param_update(const ShowNormalParamMsg& msg)
             _param_value_tag->adjustSize();
             _param_value_tag->setVisible(false); 
         }
-        if ((uint)_param_value_tag->width() > width)
-            width = _param_value_tag->width();
 
         // Add the items to the list
         // Note: If the list has items, scroll to the start of the list to reset the scroll
         if (_params_list->count()) {
             _params_list->scrollToItem(_params_list->item(0), QAbstractItemView::PositionAtCenter);
         }
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
-
+        _clear_params_list();
         for (uint i=0; i<msg.num_items; i++) {
-            _label_set_text(_dummy_label, msg.list_items[i], PARAM_LIST_WIDTH-30);
-            auto label = new QLabel(this);
-            auto item = new QListWidgetItem(_params_list);
-            label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-            _list_label_set_text(label, _dummy_label->text(), (i == msg.selected_item), msg.list_item_enabled[i], msg.list_item_separator[i]);
-            item->setSizeHint(QSize(PARAM_LIST_WIDTH, LIST_ROW_HEIGHT));
-            _params_list->addItem(item);
-            _params_list->setItemWidget(item, label);
-            _list_items.push_back(_dummy_label->text().toStdString());
+            _params_list_items.push_back(layout->list_items[i]);
             _list_items_enabled.push_back(msg.list_item_enabled[i]);
             _list_items_separator.push_back(msg.list_item_separator[i]);
         }
-
-        if (msg.selected_item < msg.num_items)
-            _params_list->setCurrentRow(msg.selected_item);
-        else
-            _params_list->setCurrentRow(0);
-        x = msg.screen_orientation == ScreenOrientation::LEFT_RIGHT ?
-                LIST_MARGIN_LEFT :
-                (PARAM_VALUE_MARGIN_LEFT_RLO + PARAM_VALUE_WIDTH + PARAM_VALUE_MARGIN_RIGHT_RLO);
-        _params_list->setGeometry(x, list_margin_top, PARAM_LIST_WIDTH, list_height);
+        _build_params_list(msg.selected_item);
+        _params_list->setGeometry(layout->list_rect);
         _params_list->setVisible(true);
 
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
@@ -549,52 +438,27 @@ void MainWindow::process_param_value_update(const ShowNormalParamUpdateMsg& msg)
         {
             // Show the param value as a text string
             str = msg.display_string;
-            _param_value->setFont(QFont(STANDARD_FONT_NAME, PARAM_VALUE_TXT_FONT_SIZE));
-            _param_value->setText(str);              
+            _param_value->set_text(str, PARAM_VALUE_WIDTH);
         }
         else 
         {
             // Show the param value as a numerical value
             str = msg.value_string;
-            _param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-            _param_value->setText(str);
+            _param_value->set_value(str, PARAM_VALUE_WIDTH);
         }
-        _param_value->adjustSize();
 
-        // Set the value geometry
-        uint width = _param_value->width();
-        while (width > PARAM_VALUE_WIDTH) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            _param_value->setText(trunc_str);
-            _param_value->adjustSize();
-            width = _param_value->width();
-        }
-        int x = msg.screen_orientation == ScreenOrientation::LEFT_RIGHT ?
-                    (VISIBLE_LCD_WIDTH - width - PARAM_VALUE_MARGIN_LEFT) :
-                    PARAM_VALUE_MARGIN_LEFT_RLO;
-        int y = _params_list->y() + ((_params_list->height() - _param_value->height()) / 2);
-        _param_value->setGeometry(x, y, width, _param_value->height());
+        // Set the value geometry - the value is aligned as on the param list
+        // screen for this orientation, but is centred on the current params list
+        // Note: The params list geometry is used rather than the layout table
+        // rect, as the list may have been shown by an EG/VCF chart screen
+        const auto& screen_layout = param_screen_layout(param_list_screen_variant((msg.screen_orientation == ScreenOrientation::LEFT_RIGHT), false));
+        auto value_rect = screen_layout.value_rect(_param_value->width(), _param_value->height());
+        value_rect.y = _params_list->y() + ((_params_list->height() - _param_value->height()) / 2);
+        _param_value->setGeometry(value_rect.rect());
 
         if (std::strlen(msg.value_tag) > 0) {
-            str = msg.value_tag;
-            _param_value_tag->setText(msg.value_tag);
-            _param_value_tag->adjustSize();
-            uint width = _param_value_tag->width();
-            while (width > PARAM_VALUE_WIDTH) {
-                str = str.mid(0, str.size() - 1);
-                QString trunc_str = str + "~";
-                _param_value_tag->setText(trunc_str);
-                _param_value_tag->adjustSize();
-                width = _param_value_tag->width();
-            }
-            x = msg.screen_orientation == ScreenOrientation::LEFT_RIGHT ?
-                    (VISIBLE_LCD_WIDTH - _param_value_tag->width() - 20) :        
-                    (_param_value_tag->width() < _param_value->width()) ?
-                        (PARAM_VALUE_MARGIN_LEFT_RLO + _param_value->width() - _param_value_tag->width()) :
-                        PARAM_VALUE_MARGIN_LEFT_RLO;
-            y += _param_value->height() + 10;
-            _param_value_tag->setGeometry (x, y, _param_value_tag->width(), _param_value_tag->height());
+            _param_value_set_text(_param_value_tag, msg.value_tag);
+            _param_value_tag->setGeometry(screen_layout.tag_rect(value_rect, _param_value_tag->width(), _param_value_tag->height()).rect());
             _param_value_tag->setVisible(true);  
         }
         else {
@@ -603,15 +467,12 @@ void MainWindow::process_param_value_update(const ShowNormalParamUpdateMsg& msg)
             _param_value_tag->setVisible(false); 
         }
 
-        if ((uint)_param_value_tag->width() > width)
-            width = _param_value_tag->width();
-
         // Check the selected item is within range
         if ((msg.selected_item != -1) && msg.selected_item < _params_list->count()) 
         {
             // Its within range, so select that row
-            _params_list->setCurrentRow(msg.selected_item);
-            
+            _list_select_row(_params_list, msg.selected_item);
+
             // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
             // Note this assumes that there are 6 items shown in the list
             uint index = msg.selected_item;
@@ -620,11 +481,6 @@ void MainWindow::process_param_value_update(const ShowNormalParamUpdateMsg& msg)
             if (index == 4)
                 index = 3;
             _params_list->scrollToItem(_params_list->item(index), QAbstractItemView::PositionAtCenter);
-
-            for (int i=0; i<_params_list->count(); i++) {
-                auto item = reinterpret_cast<QLabel *>(_params_list->itemWidget(_params_list->item(i)));
-                _list_label_set_text(item, _list_items[i].c_str(), (i == msg.selected_item), _list_items_enabled[i], _list_items_separator[i]);
-            }
         }
     }
 
@@ -639,50 +495,26 @@ void MainWindow::process_enum_param_update(const ShowEnumParamUpdateMsg& msg)
 {
     // Set a pointer to the enum list object to update
     auto enum_param_list = msg.wt_list ? _wt_enum_param_list : _enum_param_list;
-    auto list_width = msg.wt_list ? WT_LIST_WIDTH : LIST_WIDTH;
+    uint selected_item = (msg.selected_item < msg.num_items) ? msg.selected_item : 0;
     
     // Update the Left status object
     _status_bar->set_left_status(msg.name);
 
-    // Add the items to the list
-    // Note: If the list has items, scroll to the start of the list to reset the scroll
-    if (enum_param_list->count()) {
-        enum_param_list->scrollToItem(enum_param_list->item(0), QAbstractItemView::PositionAtCenter);
-    }
-    enum_param_list->clear();
-    _enum_list_items.clear();
-    for (uint i=0; i<msg.num_items; i++) {
-        msg.wt_list ?
-            _wt_label_set_text(_dummy_label, msg.list_items[i]) :
-            _label_set_text(_dummy_label, msg.list_items[i], (list_width - 30));
-        auto label = new QLabel(this);
-        auto item = new QListWidgetItem(enum_param_list);
-        label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-        if (i == msg.selected_item)
-            label->setText(_dummy_label->text());
-        else
-            label->setText("<span style='color: " + utils::get_css_system_colour_str() + "'>" + _dummy_label->text() + "</span>");
-        label->adjustSize();
-        item->setSizeHint(QSize(list_width, LIST_ROW_HEIGHT));  
-        enum_param_list->addItem(item);
-        enum_param_list->setItemWidget(item, label);
-        _enum_list_items.push_back(msg.list_items[i]);
+    // Is this item list shown or cached in the list?
+    // If so, the list does not need to be rebuilt - just re-selected
+    auto hash = _hash_list_items(msg);
+    if (!enum_param_list->show_cached_items(hash, selected_item)) {
+        // Set the items in the list
+        // Note: The list only lays out and paints the visible rows, so the
+        // cost of showing the list does not depend on the number of items
+        std::vector<MainListItem> items;
+        items.reserve(msg.num_items);
+        for (uint i=0; i<msg.num_items; i++) {
+            items.push_back({msg.list_items[i], true, false});
+        }
+        enum_param_list->set_items(items, selected_item, hash);
     }
-
-    if (msg.selected_item < msg.num_items)
-        enum_param_list->setCurrentRow(msg.selected_item);
-    else
-        enum_param_list->setCurrentRow(0);
     enum_param_list->setVisible(true);
-
-    // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
-    // Note this assumes that there are 6 items shown in the list
-    uint index = msg.selected_item;
-    if (index < 4)
-        index = 0;
-    if (index == 4)
-        index = 3;
-    enum_param_list->scrollToItem(enum_param_list->item(index), QAbstractItemView::PositionAtCenter);
     _multi_status_bar->hide();
     _show_default_background(false, false);
     _main_list->hide();
@@ -696,9 +528,7 @@ void MainWindow::process_enum_param_update(const ShowEnumParamUpdateMsg& msg)
     // Are we showing a WT list?
     if (msg.wt_list) {
         // Get the WT filename
-        auto wt_filename = (msg.selected_item < msg.num_items) ? 
-                                _enum_list_items[msg.selected_item] :
-                                _enum_list_items[0];
+        auto wt_filename = enum_param_list->item_text(selected_item).toStdString();
 
         // Load the WT file
         _wt_scope->load_wt_file(wt_filename);
@@ -723,32 +553,15 @@ void MainWindow::process_enum_param_value_update(const ListSelectItemMsg& msg)
     auto enum_param_list = msg.wt_list ? _wt_enum_param_list : _enum_param_list;
     
     // Check the selected item is within range
-    if (msg.selected_item < (uint)enum_param_list->count()) 
+    if (msg.selected_item < enum_param_list->num_items()) 
     {
         // Its within range, so select that row
-        enum_param_list->setCurrentRow(msg.selected_item);
-        
-        // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
-        // Note this assumes that there are 6 items shown in the list
-        uint index = msg.selected_item;
-        if (index < 4)
-            index = 0;
-        if (index == 4)
-            index = 3;
-        enum_param_list->scrollToItem(enum_param_list->item(index), QAbstractItemView::PositionAtCenter);
-
-        for (uint i=0; i<(uint)enum_param_list->count(); i++) {
-            auto item = reinterpret_cast<QLabel *>(enum_param_list->itemWidget(enum_param_list->item(i)));
-            if (i == msg.selected_item)
-                item->setText(_enum_list_items[i].c_str());
-            else
-                item->setText("<span style='color: " + utils::get_css_system_colour_str() + "'>" + QString(_enum_list_items[i].c_str()) + "</span>");
-        }
+        enum_param_list->select_item(msg.selected_item);
 
         // Are we showing a WT list?
         if (msg.wt_list) {
             // Load the WT file
-            _wt_scope->load_wt_file(_enum_list_items[msg.selected_item]);
+            _wt_scope->load_wt_file(enum_param_list->item_text(msg.selected_item).toStdString());
             _wt_scope->show();            
         }        
     }
@@ -820,6 +633,7 @@ void MainWindow::set_system_colour(const SetSystemColour& msg)
 {
     // Set the system colour and update the GUI objects
     utils::set_system_colour(msg.colour);
+    style_registry::rebuild();
     _set_gui_objs_system_colour();
 }
 
@@ -850,15 +664,9 @@ void MainWindow::show_adsr_envelope(const ShowAdsrEnvParamMsg& msg)
             _show_enum_param_list_obj(false);
         }
         _show_param_obj(false);
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
-
-        _eg_chart->setGeometry (EG_STD_MARGIN_LEFT,
-                                EG_STD_MARGIN_TOP,
-                                EG_STD_WIDTH,
-                                EG_STD_HEIGHT);
+        _clear_params_list();
+
+        _eg_chart->setGeometry(param_screen_layout(ParamScreenVariant::CHART_STD).chart.rect());
         _show_default_background(false, false);     
     }
     else {
@@ -870,56 +678,27 @@ void MainWindow::show_adsr_envelope(const ShowAdsrEnvParamMsg& msg)
         if (_params_list->count()) {
             _params_list->scrollToItem(_params_list->item(0), QAbstractItemView::PositionAtCenter);
         }
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
-
+        _clear_params_list();
         for (uint i=0; i<msg.num_items; i++) {
-            _label_set_text(_dummy_label, msg.list_items[i], PARAM_LIST_WIDTH-30);
-            auto label = new QLabel(this);
-            auto item = new QListWidgetItem(_params_list);
-            label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-            _list_label_set_text(label, _dummy_label->text(), (i == msg.selected_item), true, false); //msg.params.list_item_enabled[i], msg.list_item_separator[i]);
-            item->setSizeHint(QSize(PARAM_LIST_WIDTH, LIST_ROW_HEIGHT));
-            _params_list->addItem(item);
-            _params_list->setItemWidget(item, label);
-            _list_items.push_back(_dummy_label->text().toStdString());
+            _params_list_items.push_back(_elide_list_text(msg.list_items[i], PARAM_LIST_WIDTH-30));
             _list_items_enabled.push_back(true); //msg.list_item_enabled[i]);
             _list_items_separator.push_back(false); //(msg.list_item_separator[i]);
         }
+        _build_params_list(msg.selected_item);
 
-        //if (msg.selected_item < msg.num_items)
-            //_params_list->setCurrentRow(msg.selected_item);
-        //else
-            //_params_list->setCurrentRow(0);
-        _params_list->setGeometry (LIST_MARGIN_LEFT,
-                                PARAM_LIST_MARGIN_TOP, 
-                                PARAM_LIST_WIDTH,
-                                LIST_HEIGHT);            
+        // Get the param screen layout and set the list geometry
+        const auto& screen_layout = param_screen_layout(ParamScreenVariant::CHART_LIST);
+        _params_list->setGeometry(screen_layout.list.rect());
         _params_list->setVisible(true);
         _param_value_bar->hide();
 
         // Show the param value as a numerical value
         QString str = msg.value_string;
-        _param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-        _param_value->setText(str);
-        _param_value->adjustSize();
+        _param_value->set_value(str, PARAM_VALUE_WIDTH);
         _param_value->show();
 
         // Set the value geometry
-        uint width = _param_value->width();
-        while (width > PARAM_VALUE_WIDTH) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            _param_value->setText(trunc_str);
-            _param_value->adjustSize();
-            width = _param_value->width();
-        }
-        int x = (VISIBLE_LCD_WIDTH - width - PARAM_VALUE_MARGIN_LEFT);
-        //int y = STATUS_BAR_HEIGHT + ((VISIBLE_LCD_HEIGHT - STATUS_BAR_HEIGHT - BOTTOM_BAR_HEIGHT - _param_value->height()) / 2);
-        int y = _params_list->y() + (_params_list->height() / 2) + (((_params_list->height() / 2) - _param_value->height()) / 2);
-        _param_value->setGeometry(x, y, width, _param_value->height());
+        _param_value->setGeometry(screen_layout.value_rect(_param_value->width(), _param_value->height()).rect());
         _param_value_tag->hide();
 
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
@@ -930,10 +709,7 @@ void MainWindow::show_adsr_envelope(const ShowAdsrEnvParamMsg& msg)
         if (index == 4)
             index = 3;
         _params_list->scrollToItem(_params_list->item(index), QAbstractItemView::PositionAtCenter);
-        _eg_chart->setGeometry (EG_LST_MARGIN_LEFT,
-                                EG_LST_MARGIN_TOP,
-                                EG_LST_WIDTH,
-                                EG_LST_HEIGHT);
+        _eg_chart->setGeometry(screen_layout.chart.rect());
         _show_default_background(false, true);       
     }
 
@@ -965,19 +741,14 @@ void MainWindow::update_adsr_envelope(const ShowAdsrEnvParamUpdateMsg& msg)
     // Check the selected item is within range
     if ((msg.selected_item != -1) && msg.selected_item < _params_list->count()) {
         QString str = msg.value_string;
-        if (_param_value->font().pointSize() != PARAM_VALUE_NUM_FONT_SIZE) {
-            _param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-        }
-        _param_value->setText(str);
-        _param_value->adjustSize();
+        _param_value->set_value(str, PARAM_VALUE_WIDTH);
 
-        int x = (VISIBLE_LCD_WIDTH - _param_value->width() - PARAM_VALUE_MARGIN_LEFT);
-        int y = _params_list->y() + (_params_list->height() / 2) + (((_params_list->height() / 2) - _param_value->height()) / 2);
-        _param_value->setGeometry(x, y, _param_value->width(), _param_value->height());
+        const auto& screen_layout = param_screen_layout(ParamScreenVariant::CHART_LIST);
+        _param_value->setGeometry(screen_layout.value_rect(_param_value->width(), _param_value->height()).rect());
 
         // Its within range, so select that row
-        _params_list->setCurrentRow(msg.selected_item);
-        
+        _list_select_row(_params_list, msg.selected_item);
+
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
         // Note this assumes that there are 6 items shown in the list
         uint index = msg.selected_item;
@@ -987,17 +758,9 @@ void MainWindow::update_adsr_envelope(const ShowAdsrEnvParamUpdateMsg& msg)
             index = 3;
         _params_list->scrollToItem(_params_list->item(index), QAbstractItemView::PositionAtCenter);
 
-        for (int i=0; i<_params_list->count(); i++) {
-            auto item = reinterpret_cast<QLabel *>(_params_list->itemWidget(_params_list->item(i)));
-            _list_label_set_text(item, _list_items[i].c_str(), (i == msg.selected_item), _list_items_enabled[i], _list_items_separator[i]);
-        }
-
         // Set the ADSR geometry if needed
-        if (_eg_chart->x() != EG_LST_MARGIN_LEFT) {
-            _eg_chart->setGeometry (EG_LST_MARGIN_LEFT,
-                                    EG_LST_MARGIN_TOP,
-                                    EG_LST_WIDTH,
-                                    EG_LST_HEIGHT);
+        if (_eg_chart->x() != screen_layout.chart.x) {
+            _eg_chart->setGeometry(screen_layout.chart.rect());
         }      
     }
     else {
@@ -1018,11 +781,9 @@ void MainWindow::update_adsr_envelope(const ShowAdsrEnvParamUpdateMsg& msg)
         _param_value_bar->show();
 
         // Set the ADSR geometry if needed
-        if (_eg_chart->x() != EG_STD_MARGIN_LEFT) {
-            _eg_chart->setGeometry (EG_STD_MARGIN_LEFT,
-                                    EG_STD_MARGIN_TOP,
-                                    EG_STD_WIDTH,
-                                    EG_STD_HEIGHT);
+        const auto& chart_rect = param_screen_layout(ParamScreenVariant::CHART_STD).chart;
+        if (_eg_chart->x() != chart_rect.x) {
+            _eg_chart->setGeometry(chart_rect.rect());
         }
         _show_default_background(false, false);
     }
@@ -1060,15 +821,9 @@ void MainWindow::show_vcf_cutoff(const ShowVcfCutoffParamMsg& msg)
             _show_enum_param_list_obj(false);
         }
         _show_param_obj(false);
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
-
-        _vcf_cutoff_chart->setGeometry (EG_STD_MARGIN_LEFT,
-                                        EG_STD_MARGIN_TOP,
-                                        EG_STD_WIDTH,
-                                        EG_STD_HEIGHT);
+        _clear_params_list();
+
+        _vcf_cutoff_chart->setGeometry(param_screen_layout(ParamScreenVariant::CHART_STD).chart.rect());
         _show_default_background(false, false);           
     }
     else {
@@ -1083,56 +838,27 @@ void MainWindow::show_vcf_cutoff(const ShowVcfCutoffParamMsg& msg)
         if (_params_list->count()) {
             _params_list->scrollToItem(_params_list->item(0), QAbstractItemView::PositionAtCenter);
         }
-        _params_list->clear();
-        _list_items.clear();
-        _list_items_enabled.clear();
-        _list_items_separator.clear();
-
+        _clear_params_list();
         for (uint i=0; i<msg.num_items; i++) {
-            _label_set_text(_dummy_label, msg.list_items[i], PARAM_LIST_WIDTH-30);
-            auto label = new QLabel(this);
-            auto item = new QListWidgetItem(_params_list);
-            label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-            _list_label_set_text(label, _dummy_label->text(), (i == msg.selected_item), true, false); //msg.params.list_item_enabled[i], msg.list_item_separator[i]);
-            item->setSizeHint(QSize(PARAM_LIST_WIDTH, LIST_ROW_HEIGHT));
-            _params_list->addItem(item);
-            _params_list->setItemWidget(item, label);
-            _list_items.push_back(_dummy_label->text().toStdString());
+            _params_list_items.push_back(_elide_list_text(msg.list_items[i], PARAM_LIST_WIDTH-30));
             _list_items_enabled.push_back(true); //msg.list_item_enabled[i]);
             _list_items_separator.push_back(false); //(msg.list_item_separator[i]);
         }
+        _build_params_list(msg.selected_item);
 
-        //if (msg.selected_item < msg.num_items)
-            //_params_list->setCurrentRow(msg.selected_item);
-        //else
-            //_params_list->setCurrentRow(0);
-        _params_list->setGeometry (LIST_MARGIN_LEFT,
-                                PARAM_LIST_MARGIN_TOP, 
-                                PARAM_LIST_WIDTH,
-                                LIST_HEIGHT);             
+        // Get the param screen layout and set the list geometry
+        const auto& screen_layout = param_screen_layout(ParamScreenVariant::CHART_LIST);
+        _params_list->setGeometry(screen_layout.list.rect());
         _params_list->setVisible(true);
         _param_value_bar->hide();
 
         // Show the param value as a numerical value
         QString str = msg.value_string;
-        _param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-        _param_value->setText(str);
-        _param_value->adjustSize();
+        _param_value->set_value(str, PARAM_VALUE_WIDTH);
         _param_value->show();
 
         // Set the value geometry
-        uint width = _param_value->width();
-        while (width > PARAM_VALUE_WIDTH) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            _param_value->setText(trunc_str);
-            _param_value->adjustSize();
-            width = _param_value->width();
-        }
-        int x = (VISIBLE_LCD_WIDTH - width - PARAM_VALUE_MARGIN_LEFT);
-        //int y = STATUS_BAR_HEIGHT + ((VISIBLE_LCD_HEIGHT - STATUS_BAR_HEIGHT - BOTTOM_BAR_HEIGHT - _param_value->height()) / 2);
-        int y = _params_list->y() + (_params_list->height() / 2) + (((_params_list->height() / 2) - _param_value->height()) / 2);
-        _param_value->setGeometry(x, y, width, _param_value->height());
+        _param_value->setGeometry(screen_layout.value_rect(_param_value->width(), _param_value->height()).rect());
         _param_value_tag->hide();
 
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
@@ -1143,10 +869,7 @@ void MainWindow::show_vcf_cutoff(const ShowVcfCutoffParamMsg& msg)
         if (index == 4)
             index = 3;
         _params_list->scrollToItem(_params_list->item(index), QAbstractItemView::PositionAtCenter);
-        _vcf_cutoff_chart->setGeometry (EG_LST_MARGIN_LEFT,
-                                        EG_LST_MARGIN_TOP,
-                                        EG_LST_WIDTH,
-                                        EG_LST_HEIGHT);
+        _vcf_cutoff_chart->setGeometry(screen_layout.chart.rect());
         _show_default_background(false, true);        
     }
 
@@ -1178,15 +901,13 @@ void MainWindow::update_vcf_cutoff(const ShowVcfCutoffParamUpdateMsg& msg)
     // Check the selected item is within range
     if ((msg.selected_item != -1) && msg.selected_item < _params_list->count()) {
         // Its within range, so select that row
-        _params_list->setCurrentRow(msg.selected_item);
+        _list_select_row(_params_list, msg.selected_item);
 
         QString str = msg.value_string;
-        _param_value->setText(str);
-        _param_value->adjustSize();
+        _param_value->set_value(str, PARAM_VALUE_WIDTH);
 
-        int x = (VISIBLE_LCD_WIDTH - _param_value->width() - PARAM_VALUE_MARGIN_LEFT);
-        int y = _params_list->y() + (_params_list->height() / 2) + (((_params_list->height() / 2) - _param_value->height()) / 2);
-        _param_value->setGeometry(x, y, _param_value->width(), _param_value->height());
+        const auto& screen_layout = param_screen_layout(ParamScreenVariant::CHART_LIST);
+        _param_value->setGeometry(screen_layout.value_rect(_param_value->width(), _param_value->height()).rect());
 
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh)
         // Note this assumes that there are 6 items shown in the list
@@ -1196,11 +917,6 @@ void MainWindow::update_vcf_cutoff(const ShowVcfCutoffParamUpdateMsg& msg)
         if (index == 4)
             index = 3;
         _params_list->scrollToItem(_params_list->item(index), QAbstractItemView::PositionAtCenter);
-
-        for (int i=0; i<_params_list->count(); i++) {
-            auto item = reinterpret_cast<QLabel *>(_params_list->itemWidget(_params_list->item(i)));
-            _list_label_set_text(item, _list_items[i].c_str(), (i == msg.selected_item), _list_items_enabled[i], _list_items_separator[i]);
-        }
     }
     else {
         // Was a display string specified? If so - show this as the value
@@ -1281,10 +997,9 @@ void MainWindow::_create_gui_objs()
     _params_list = new QListWidget(this);
     _params_list->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     _params_list->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    _params_list->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
+    _params_list->setFont(style_registry::font(STANDARD_FONT_NAME, LIST_FONT_SIZE));
     _params_list->setSpacing(0);
-	_params_list->setStyleSheet(
-        "QListWidget { border: 0px; background-color: transparent; color : " + utils::get_css_system_colour_str() + "; }");
+	_params_list->setStyleSheet(style_registry::css(style_registry::Css::PARAM_LIST));
     _params_list->hide();
     _params_list->setGeometry (LIST_MARGIN_LEFT,
                                LIST_MARGIN_TOP, 
@@ -1292,42 +1007,25 @@ void MainWindow::_create_gui_objs()
                                LIST_HEIGHT);
     
     // Create the Param Value object
-    _param_value = new QLabel(this);
-	_param_value->setFont(QFont(PARAM_VALUE_FONT_NAME, PARAM_VALUE_NUM_FONT_SIZE));
-	_param_value->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
+    _param_value = new ParamValue(this);
     _params_list->hide();
 
     // Create the Param Value tag object
     _param_value_tag = new QLabel(this);
-	_param_value_tag->setFont(QFont(STANDARD_FONT_NAME, PARAM_VALUE_TAG_FONT_SIZE));
-	_param_value_tag->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
+	_param_value_tag->setFont(style_registry::font(STANDARD_FONT_NAME, PARAM_VALUE_TAG_FONT_SIZE));
+	_param_value_tag->setStyleSheet(style_registry::css(style_registry::Css::LABEL));
     _param_value_tag->hide();
 
     // Create the Enum Param List object
-    _enum_param_list = new QListWidget(this);
-    _enum_param_list->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    _enum_param_list->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    _enum_param_list->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-	_enum_param_list->setStyleSheet(
-        "QListWidget { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item { padding-left: 20px; padding-right: 10px; border-bottom-width: 0.5px; border-bottom-style: solid; border-bottom-color: " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item::selected { color: black; background: " + utils::get_css_system_colour_str() + "; }");
-    _enum_param_list->hide();
+    _enum_param_list = new MainList(NUM_LIST_ROWS, this, text_elider::ElideStyle::RIGHT, ENUM_LIST_TEXT_MARGIN);
     _enum_param_list->setGeometry (LIST_MARGIN_LEFT,
                                    LIST_MARGIN_TOP, 
                                    LIST_WIDTH,
                                    LIST_HEIGHT);
 
     // Create the WT Enum Param List object
-    _wt_enum_param_list = new QListWidget(this);
-    _wt_enum_param_list->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    _wt_enum_param_list->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    _wt_enum_param_list->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-	_wt_enum_param_list->setStyleSheet(
-        "QListWidget { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item { padding-left: 20px; padding-right: 10px; border-bottom-width: 0.5px; border-bottom-style: solid; border-bottom-color: " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item::selected { color: black; background: " + utils::get_css_system_colour_str() + "; }");
-    _wt_enum_param_list->hide();
+    // Note: The end of the WT filename is always kept when elided
+    _wt_enum_param_list = new MainList(NUM_LIST_ROWS, this, text_elider::ElideStyle::MIDDLE_KEEP_EXT, ENUM_LIST_TEXT_MARGIN);
     _wt_enum_param_list->setGeometry (LIST_MARGIN_LEFT,
                                       LIST_MARGIN_TOP, 
                                       WT_LIST_WIDTH,
@@ -1335,10 +1033,7 @@ void MainWindow::_create_gui_objs()
 
     // Create the envelope scope
     _eg_chart = new EgChart(this);
-    _eg_chart->setGeometry (EG_STD_MARGIN_LEFT,
-                            EG_STD_MARGIN_TOP,
-                            EG_STD_WIDTH,
-                            EG_STD_HEIGHT);
+    _eg_chart->setGeometry(param_screen_layout(ParamScreenVariant::CHART_STD).chart.rect());
 
     // Create the cutoff chart
     _vcf_cutoff_chart = new VcfCutoffChart(this);
@@ -1353,6 +1048,9 @@ void MainWindow::_create_gui_objs()
                             WT_CHART_MARGIN_TOP,
                             WT_CHART_WIDTH,
                             WT_CHART_HEIGHT);
+    if (utils::get_wt_waterfall_view()) {
+        _wt_scope->set_mode(WtScopeMode::WATERFALL);
+    }
 
     // Create the Main List object
     _main_list = new MainList(NUM_LIST_ROWS, this);    
@@ -1378,11 +1076,8 @@ void MainWindow::_create_gui_objs()
     _boot_warning_background = new Background(this);
     _boot_warning_background->set_image(BOOT_WARNING_PNG_RES);
 
-    // Create the dummy label - not visible
-    // This is used to calculate max string lengths (generally used in lists)
-    _dummy_label = new QLabel(this);
-	_dummy_label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE)); 
-    _dummy_label->setVisible(false);
+    // Set the list font - this is also used to calculate max string lengths
+    _list_font = style_registry::font(STANDARD_FONT_NAME, LIST_FONT_SIZE);
 }
 
 //----------------------------------------------------------------------------
@@ -1410,26 +1105,19 @@ void MainWindow::_set_gui_objs_system_colour()
     _bottom_bar->refresh_colour();
 
     // Params List object
-	_params_list->setStyleSheet(
-        "QListWidget { background-color: transparent; color : " + utils::get_css_system_colour_str() + "; }");
+	_params_list->setStyleSheet(style_registry::css(style_registry::Css::PARAM_LIST));
     
     // Param Value object
-	_param_value->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
+	_param_value->refresh_colour();
 
     // Param Value tag object
-	_param_value_tag->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
+	_param_value_tag->setStyleSheet(style_registry::css(style_registry::Css::LABEL));
 
     // num Param List object
-	_enum_param_list->setStyleSheet(
-        "QListWidget { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item { padding-left: 20px; padding-right: 10px; border-bottom-width: 0.5px; border-bottom-style: solid; border-bottom-color: " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item::selected { color: black; background: " + utils::get_css_system_colour_str() + "; }");
+	_enum_param_list->refresh_colour();
 
     // WT enum param list
-	_wt_enum_param_list->setStyleSheet(
-        "QListWidget { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item { padding-left: 20px; padding-right: 10px; border-bottom-width: 0.5px; border-bottom-style: solid; border-bottom-color: " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item::selected { color: black; background: " + utils::get_css_system_colour_str() + "; }");
+	_wt_enum_param_list->refresh_colour();
 
     // EG chart
     _eg_chart->refresh_colour();
@@ -1521,126 +1209,114 @@ void MainWindow::_show_enum_param_list_obj(bool show)
 }
 
 //----------------------------------------------------------------------------
-// _label_set_text
+// _list_select_row
 //----------------------------------------------------------------------------
-void MainWindow::_label_set_text(QLabel *label, const char *text, int max_width)
+void MainWindow::_list_select_row(QListWidget *list, int row)
 {
-    QString str = text;
-
-    // Update the object text
-    label->setText(str);
-    label->adjustSize();
-    if (max_width != -1) {
-        uint width = label->width();
-        while (width > (uint)max_width) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            label->setText(trunc_str);
-            label->adjustSize();
-            width = label->width();
+    // Only the previously and newly selected rows need restyling, so the
+    // cost of a selection change does not depend on the list length
+    // Note: Rows that have not been created yet get their selected state when
+    // they are created
+    int prev_row = list->currentRow();
+    list->setCurrentRow(row);
+    if ((prev_row >= 0) && (prev_row < list->count()) && (prev_row != row)) {
+        auto list_row = static_cast<ListRow *>(list->itemWidget(list->item(prev_row)));
+        if (list_row) {
+            list_row->set_selected(false);
+        }
+    }
+    if ((row >= 0) && (row < list->count())) {
+        auto list_row = static_cast<ListRow *>(list->itemWidget(list->item(row)));
+        if (list_row) {
+            list_row->set_selected(true);
         }
     }
 }
 
 //----------------------------------------------------------------------------
-// _wt_label_set_text
+// _clear_params_list
 //----------------------------------------------------------------------------
-void MainWindow::_wt_label_set_text(QLabel *label, const char *text)
+void MainWindow::_clear_params_list()
 {
-    // Get the start and end strings to use if string truncation is needed
-    QString str1 = text;
-    QString str2 = text;
-    str1 = str1.mid(0, (str1.size() - 3));
-    str2 = str2.mid((str2.size()-3), 3);
-
-    // Update the object text
-    label->setText(text);
-    label->adjustSize();
-    uint width = label->width();
-    while (width > (WT_LIST_WIDTH - 30)) {
-        str1 = str1.mid(0, str1.size() - 1);
-        QString trunc_str = str1 + "~" + str2;
-        label->setText(trunc_str);
-        label->adjustSize();
-        width = label->width();
-    }
+    // Stop creating any remaining rows, and clear the list
+    _frame_scheduler->cancel(_params_list);
+    _params_list->clear();
+    _params_list_items.clear();
+    _list_items_enabled.clear();
+    _list_items_separator.clear();
 }
 
 //----------------------------------------------------------------------------
-// _list_label_set_text
+// _build_params_list
 //----------------------------------------------------------------------------
-void MainWindow::_list_label_set_text(QLabel *label, QString text, bool selected, bool enabled, bool separator)
+void MainWindow::_build_params_list(int selected_item)
 {
-    QString fontColour = utils::get_css_system_colour_str() + ";";
-    QString bgColour = "transparent;";
-    QString paddingTop = "0px;";
-    QString borderStyle = "solid;";
-    QString borderWidth = "0.5px;";
-    QString borderColour = utils::get_css_system_colour_str() + ";";
-
-    // Set the param list label text depending on the state of this list item
-    if (selected) {
-        if (!enabled) {
-            // Show the text dimmed
-            fontColour = utils::get_dimmed_css_system_colour_str();
-        }
-        else {
-            fontColour = "black;";
-        }
-        bgColour = utils::get_css_system_colour_str() + ";";
-        if (separator) {
-            borderColour = "black;";
-        }            
+    int num_items = _params_list_items.size();
+
+    // Add the list items and set the selected item
+    // Note: The list items are cheap to create, the row widgets are not
+    for (int i=0; i<num_items; i++) {
+        auto item = new QListWidgetItem(_params_list);
+        item->setSizeHint(QSize(PARAM_LIST_WIDTH, LIST_ROW_HEIGHT));
     }
-    else {
-        if (!enabled) {
-            // Show the text dimmed
-            fontColour = utils::get_dimmed_css_system_colour_str();
-        }               
+    if ((selected_item >= 0) && (selected_item < num_items)) {
+        _params_list->setCurrentRow(selected_item);
+    }
+    
+    // Create the row widgets that can be visible around the selected row now
+    int first_row = std::max(0, std::min(selected_item, (num_items - 1)) - (int)NUM_LIST_ROWS);
+    int last_row = std::min((num_items - 1), (first_row + (2 * (int)NUM_LIST_ROWS)));
+    for (int i=first_row; i<=last_row; i++) {
+        _params_list_create_row(i);
+    }
+
+    // Create any remaining row widgets in later frames, within the frame budget
+    if ((last_row - first_row + 1) < num_items) {
+        int next_row = 0;
+        _frame_scheduler->schedule(_params_list, [this, next_row]() mutable {
+            // Create the next row that has not been created yet
+            while (next_row < _params_list->count()) {
+                if (!_params_list->itemWidget(_params_list->item(next_row))) {
+                    _params_list_create_row(next_row++);
+                    break;
+                }
+                next_row++;
+            }
+            return (next_row >= _params_list->count());
+        });
     }
-    if (separator) {
-        paddingTop = "2.0px;";
-        borderStyle = "dotted;";
-        borderWidth = "3.0px;";
-    }        
-    label->setText(text);
-    label->setStyleSheet(
-        "QLabel { color:" + fontColour + "; background-color:" + bgColour + 
-        "padding-left: 20px; padding-right: 10px; padding-top:" + paddingTop +
-        "border-style:" + borderStyle + "border-bottom-width:" + borderWidth + "border-color:" + borderColour + "; }");
 }
 
 //----------------------------------------------------------------------------
-// _list_add_item
+// _params_list_create_row
 //----------------------------------------------------------------------------
-void MainWindow::_list_add_item(QListWidget *list, const char *text, int list_width)
+void MainWindow::_params_list_create_row(int index)
 {
-    // Firstly find the text we can display, truncated if necessary
-    // We do this with the dummy QLabel object  
-    _label_set_text(_dummy_label, text, list_width);
-
-    // Add the item to the list
-    list->addItem(_dummy_label->text());
-    auto item = list->item(list->count() - 1);
-    item->setSizeHint(QSize(list_width, LIST_ROW_HEIGHT));   
+    // Create the row widget if not already created
+    auto item = _params_list->item(index);
+    if (!_params_list->itemWidget(item)) {
+        auto row = new ListRow(ListRowStyle::BOXED, _list_font, this);
+        row->set_text(_params_list_items[index]);
+        row->set_state((index == _params_list->currentRow()), _list_items_enabled[index], _list_items_separator[index]);
+        _params_list->setItemWidget(item, row);
+    }
 }
 
 //----------------------------------------------------------------------------
-// _list_add_item
+// _elide_list_text
 //----------------------------------------------------------------------------
-void MainWindow::_list_add_item(QListWidget *list, const char *text, int list_width, bool selected, bool enabled)
+QString MainWindow::_elide_list_text(const char *text, int max_width)
 {
-    // Firstly find the text we can display, truncated if necessary
-    // We do this with the dummy QLabel object  
-    _label_set_text(_dummy_label, text, list_width);
-    auto label = new QLabel(this);
-    auto item = new QListWidgetItem(list);
-    label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-    _list_label_set_text(label, _dummy_label->text(), selected, enabled, false);
-    item->setSizeHint(QSize(list_width, LIST_ROW_HEIGHT));
-    list->addItem(item);
-    list->setItemWidget(item, label);
-
-    _list_items.push_back(_dummy_label->text().toStdString());
-    _list_items_enabled.push_back(enabled);  
+    // Return the list text, truncated if necessary
+    return text_elider::elide(text, _list_font, max_width).text;
+}
+
+//----------------------------------------------------------------------------
+// _param_value_set_text
+//----------------------------------------------------------------------------
+void MainWindow::_param_value_set_text(QLabel *label, const QString& text)
+{
+    // Set the param value text, truncated if necessary
+    label->setText(text_elider::elide(text, label->font(), PARAM_VALUE_WIDTH).text);
+    label->adjustSize();
 }
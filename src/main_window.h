@@ -18,15 +18,18 @@
 #include <QTimer>
 #include "background.h"
 #include "timer.h"
+#include "frame_scheduler.h"
 #include "gui_msg_thread.h"
 #include "status_bar.h"
 #include "multi_status_bar.h"
+#include "param_value.h"
 #include "param_value_bar.h"
 #include "bottom_bar.h"
 #include "sound_scope.h"
 #include "wt_scope.h"
 #include "eg_chart.h"
 #include "vcf_cutoff_chart.h"
+#include "list_row.h"
 #include "main_list.h"
 #include "edit_name.h"
 #include "msg_box.h"
@@ -61,7 +64,7 @@ public slots:
     void select_layer_name(const SelectLayerNameMsg& msg);
     void set_soft_buttons_text(const SetSoftButtonsTextMsg& msg);
     void set_soft_buttons_state(const SetSoftButtonsStateMsg& msg);
-    void process_param_update(const ShowNormalParamMsg& msg);
+    void process_param_update(const ShowNormalParamMsg& msg, ParamLayoutPtr layout);
     void process_param_value_update(const ShowNormalParamUpdateMsg& msg);
     void process_enum_param_update(const ShowEnumParamUpdateMsg& msg);
     void process_enum_param_value_update(const ListSelectItemMsg& msg);
@@ -97,17 +100,17 @@ private:
     MsgPopup *_msg_popup;
     SoundScopeMode _sound_scope_mode;
     GuiMsgThread *_gui_msg_thread;
+    FrameScheduler *_frame_scheduler;
     SoundScopeMsgThread *_sound_scope_msg_thread;
-    QLabel *_param_value;
+    ParamValue *_param_value;
     QLabel *_param_value_tag;
     QListWidget *_params_list;
-    QListWidget *_enum_param_list;
-    QListWidget *_wt_enum_param_list;
-    QLabel *_dummy_label;
-    std::vector<std::string> _list_items;
+    MainList *_enum_param_list;
+    MainList *_wt_enum_param_list;
+    QFont _list_font;
+    std::vector<QString> _params_list_items;
     std::vector<bool> _list_items_enabled;
     std::vector<bool> _list_items_separator;
-    std::vector<std::string> _enum_list_items;
     std::vector<Param> _params;
     uint _screen_capture_index;
 
@@ -118,11 +121,12 @@ private:
     void _show_enum_param_list_obj(bool show);
     void _create_gui_objs();
     void _set_gui_objs_system_colour();  
-    void _label_set_text(QLabel *label, const char *text, int max_width);
-    void _wt_label_set_text(QLabel *label, const char *text);
-    void _list_label_set_text(QLabel *label, QString text, bool selected, bool enabled, bool separator);
-    void _list_add_item(QListWidget *list, const char *text, int list_width);
-    void _list_add_item(QListWidget *list, const char *text, int list_width, bool selected, bool enabled);
+    void _list_select_row(QListWidget *list, int row);
+    void _clear_params_list();
+    void _build_params_list(int selected_item);
+    void _params_list_create_row(int index);
+    QString _elide_list_text(const char *text, int max_width);
+    void _param_value_set_text(QLabel *label, const QString& text);
 };
 
 #endif
@@ -0,0 +1,67 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  param_layout.cpp
+ * @brief Param Layout class implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <QFontMetrics>
+#include "param_layout.h"
+#include "text_elider.h"
+
+//----------------------------------------------------------------------------
+// ParamLayoutEngine
+//----------------------------------------------------------------------------
+ParamLayoutEngine::ParamLayoutEngine() :
+    _tag_font(STANDARD_FONT_NAME, PARAM_VALUE_TAG_FONT_SIZE),
+    _list_font(STANDARD_FONT_NAME, LIST_FONT_SIZE)
+{
+    // Get the tag font height
+    // Note: The engine creates its own fonts rather than copying them from the
+    // style registry, as copies would share the registry font data used by
+    // the GUI thread
+    _tag_height = QFontMetrics(_tag_font).height();
+}
+
+//----------------------------------------------------------------------------
+// layout
+//----------------------------------------------------------------------------
+ParamLayoutPtr ParamLayoutEngine::layout(const ShowNormalParamMsg& msg) const
+{
+    // If just a single param is shown (in the param value bar), there is
+    // nothing to lay out
+    if ((msg.num_items == 0) && !msg.force_show_list) {
+        return nullptr;
+    }
+    auto layout = std::make_shared<ParamLayout>();
+
+    // Get the screen layout for this variant
+    layout->show_multi_status_bar = (std::strlen(msg.l1_patch_name) > 0) && (std::strlen(msg.l2_patch_name) > 0);
+    layout->variant = param_list_screen_variant((msg.screen_orientation == ScreenOrientation::LEFT_RIGHT), layout->show_multi_status_bar);
+    const auto& screen_layout = param_screen_layout(layout->variant);
+
+    // Measure the value - was a display string specified? If so - show this
+    // as the value, otherwise show the numerical value
+    layout->value = (std::strlen(msg.display_string) > 0) ?
+                        _value_metrics.text(msg.display_string, PARAM_VALUE_WIDTH) :
+                        _value_metrics.value(msg.value_string, PARAM_VALUE_WIDTH);
+    auto value_rect = screen_layout.value_rect(layout->value.size.width(), layout->value.size.height());
+    layout->value_rect = value_rect.rect();
+
+    // Measure the value tag (if any), which is shown below the value
+    layout->show_tag = std::strlen(msg.value_tag) > 0;
+    if (layout->show_tag) {
+        auto elided = text_elider::elide(msg.value_tag, _tag_font, PARAM_VALUE_WIDTH);
+        layout->tag_text = elided.text;
+        layout->tag_rect = screen_layout.tag_rect(value_rect, elided.width, _tag_height).rect();
+    }
+
+    // Elide the list items
+    layout->list_items.reserve(msg.num_items);
+    for (uint i=0; i<msg.num_items; i++) {
+        layout->list_items.push_back(text_elider::elide(msg.list_items[i], _list_font, (PARAM_LIST_WIDTH - 30)).text);
+    }
+    layout->list_rect = screen_layout.list.rect();
+    return layout;
+}
@@ -0,0 +1,60 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  param_layout.h
+ * @brief Param Layout class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef PARAM_LAYOUT_H
+#define PARAM_LAYOUT_H
+
+#include <memory>
+#include <vector>
+#include <QFont>
+#include <QMetaType>
+#include <QRect>
+#include <QString>
+#include "gui_msg.h"
+#include "param_value.h"
+#include "screen_layout.h"
+
+// Param Layout - the elided text and geometry of each param screen object
+// Note: Once created the layout is never modified, so it can be safely
+// passed from the GUI message thread to the GUI thread
+struct ParamLayout
+{
+    ParamScreenVariant variant;
+    bool show_multi_status_bar;
+    ParamValueLayout value;
+    QRect value_rect;
+    bool show_tag;
+    QString tag_text;
+    QRect tag_rect;
+    QRect list_rect;
+    std::vector<QString> list_items;
+};
+typedef std::shared_ptr<const ParamLayout> ParamLayoutPtr;
+Q_DECLARE_METATYPE(ParamLayoutPtr)
+
+// Param Layout Engine class
+// Measures, elides and positions the param screen objects - this only uses
+// font metrics, so it can be run off the GUI thread
+class ParamLayoutEngine
+{
+public:
+    // Constructor
+    ParamLayoutEngine();
+
+    // Public functions
+    ParamLayoutPtr layout(const ShowNormalParamMsg& msg) const;
+
+private:
+    // Private data
+    ParamValueMetrics _value_metrics;
+    QFont _tag_font;
+    QFont _list_font;
+    int _tag_height;
+};
+
+#endif  // PARAM_LAYOUT_H
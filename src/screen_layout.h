@@ -0,0 +1,236 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  screen_layout.h
+ * @brief Screen layout definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef SCREEN_LAYOUT_H
+#define SCREEN_LAYOUT_H
+
+#include <QRect>
+#include "gui_common.h"
+
+// Screen layout constants
+// Note: These are shared by the main window and the param layout engine,
+// which lays out the param screen on the GUI message thread
+constexpr uint VISIBLE_LCD_MARGIN_LEFT      = 9;
+constexpr uint VISIBLE_LCD_MARGIN_RIGHT     = 1;
+constexpr uint VISIBLE_LCD_WIDTH            = (LCD_WIDTH - VISIBLE_LCD_MARGIN_LEFT - VISIBLE_LCD_MARGIN_RIGHT);
+constexpr uint VISIBLE_LCD_MARGIN_TOP       = 5;
+constexpr uint VISIBLE_LCD_MARGIN_BOTTOM    = 5;
+constexpr uint VISIBLE_LCD_HEIGHT           = (LCD_HEIGHT - VISIBLE_LCD_MARGIN_TOP - VISIBLE_LCD_MARGIN_BOTTOM);
+constexpr uint STATUS_BAR_MARGIN_LEFT       = VISIBLE_LCD_MARGIN_LEFT;
+constexpr uint STATUS_BAR_MARGIN_TOP        = VISIBLE_LCD_MARGIN_TOP;
+constexpr uint STATUS_BAR_WIDTH             = VISIBLE_LCD_WIDTH;
+constexpr uint STATUS_BAR_HEIGHT            = 60;
+constexpr uint MULTI_STATUS_BAR_MARGIN_LEFT = VISIBLE_LCD_MARGIN_LEFT;
+constexpr uint MULTI_STATUS_BAR_MARGIN_TOP  = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 3);
+constexpr uint MULTI_STATUS_BAR_WIDTH       = VISIBLE_LCD_WIDTH;
+constexpr uint MULTI_STATUS_BAR_HEIGHT      = 46;
+constexpr uint MAIN_AREA_MARGIN_LEFT        = VISIBLE_LCD_MARGIN_LEFT;
+constexpr uint MAIN_AREA_MARGIN_TOP         = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT);
+constexpr uint MAIN_AREA_WIDTH              = VISIBLE_LCD_WIDTH;
+constexpr uint MAIN_AREA_HEIGHT             = 338;
+constexpr uint BOTTOM_BAR_MARGIN_LEFT       = VISIBLE_LCD_MARGIN_LEFT;
+constexpr uint BOTTOM_BAR_MARGIN_TOP        = (MAIN_AREA_MARGIN_TOP + MAIN_AREA_HEIGHT);
+constexpr uint BOTTOM_BAR_WIDTH             = VISIBLE_LCD_WIDTH;
+constexpr uint BOTTOM_BAR_HEIGHT            = (VISIBLE_LCD_HEIGHT - BOTTOM_BAR_MARGIN_TOP);
+constexpr uint LIST_MARGIN_LEFT             = VISIBLE_LCD_MARGIN_LEFT;
+constexpr uint LIST_MARGIN_TOP              = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 1);
+constexpr uint LIST_WIDTH                   = VISIBLE_LCD_WIDTH;
+constexpr uint LIST_ROW_HEIGHT              = 48;
+constexpr uint NUM_LIST_ROWS                = 7;
+constexpr uint LIST_HEIGHT                  = (7 * LIST_ROW_HEIGHT);
+constexpr uint LIST_FONT_SIZE               = 30;
+constexpr uint PARAM_LIST_MARGIN_TOP        = (STATUS_BAR_MARGIN_TOP + STATUS_BAR_HEIGHT + 3);
+constexpr uint PARAM_LIST_WIDTH             = (VISIBLE_LCD_WIDTH/2);
+constexpr uint PARAM_VALUE_MARGIN_LEFT      = 10;
+constexpr uint PARAM_VALUE_MARGIN_LEFT_RLO  = (VISIBLE_LCD_MARGIN_LEFT + 10);
+constexpr uint PARAM_VALUE_MARGIN_RIGHT     = PARAM_LIST_WIDTH + 10;
+constexpr uint PARAM_VALUE_MARGIN_RIGHT_RLO = 10;
+constexpr uint PARAM_VALUE_WIDTH            = (VISIBLE_LCD_WIDTH - PARAM_VALUE_MARGIN_RIGHT - PARAM_VALUE_MARGIN_LEFT);
+constexpr uint PARAM_VALUE_TAG_FONT_SIZE    = 30;
+constexpr uint WT_LIST_WIDTH                = (VISIBLE_LCD_WIDTH/2);
+constexpr uint WT_CHART_MARGIN_LEFT         = (LIST_MARGIN_LEFT + WT_LIST_WIDTH + 10);
+constexpr uint WT_CHART_MARGIN_TOP          = (LIST_MARGIN_TOP + 10);
+constexpr uint WT_CHART_WIDTH               = (VISIBLE_LCD_WIDTH - WT_LIST_WIDTH - 20);
+constexpr uint WT_CHART_HEIGHT              = LIST_HEIGHT - 20;
+constexpr uint EG_STD_MARGIN_LEFT           = (VISIBLE_LCD_WIDTH - 600) / 2 ;
+constexpr uint EG_STD_MARGIN_TOP            = MULTI_STATUS_BAR_MARGIN_TOP + MULTI_STATUS_BAR_HEIGHT + 10;
+constexpr uint EG_STD_WIDTH                 = 600;
+constexpr uint EG_STD_HEIGHT                = MAIN_AREA_HEIGHT - MULTI_STATUS_BAR_HEIGHT - 20;
+constexpr uint EG_LST_MARGIN_LEFT           = (LIST_MARGIN_LEFT + PARAM_LIST_WIDTH + 10);
+constexpr uint EG_LST_MARGIN_TOP            = LIST_MARGIN_TOP + 10;
+constexpr uint EG_LST_WIDTH                 = (VISIBLE_LCD_WIDTH - PARAM_LIST_WIDTH - 20);
+constexpr uint EG_LST_HEIGHT                = (LIST_HEIGHT / 2) - 20;
+constexpr uint VCF_CUTOFF_MARGIN_LEFT       = (LIST_MARGIN_LEFT + PARAM_LIST_WIDTH + 10);
+constexpr uint VCF_CUTOFF_MARGIN_TOP        = LIST_MARGIN_TOP + 10;
+constexpr uint VCF_CUTOFF_WIDTH             = (VISIBLE_LCD_WIDTH - PARAM_LIST_WIDTH - 20);
+constexpr uint VCF_CUTOFF_HEIGHT            = LIST_HEIGHT - 20;
+constexpr uint SOUND_SCOPE_MARGIN_TOP       = (MAIN_AREA_MARGIN_TOP + 15);
+constexpr uint SOUND_SCOPE_HEIGHT           = (MAIN_AREA_HEIGHT - 15);
+constexpr uint OSC_SOUND_SCOPE_WIDTH        = VISIBLE_LCD_WIDTH;
+constexpr uint XY_SOUND_SCOPE_WIDTH         = SOUND_SCOPE_HEIGHT;
+constexpr uint OSC_SOUND_SCOPE_MARGIN_LEFT  = MAIN_AREA_MARGIN_LEFT;
+constexpr uint XY_SOUND_SCOPE_MARGIN_LEFT   = MAIN_AREA_MARGIN_LEFT + ((VISIBLE_LCD_WIDTH - XY_SOUND_SCOPE_WIDTH) / 2);
+
+
+// Screen layout rect
+struct LayoutRect
+{
+    int x;
+    int y;
+    int width;
+    int height;
+
+    constexpr bool operator==(const LayoutRect& other) const
+    {
+        return (x == other.x) && (y == other.y) && (width == other.width) && (height == other.height);
+    }
+
+    QRect rect() const
+    {
+        return QRect(x, y, width, height);
+    }
+};
+
+// Param screen variants
+enum class ParamScreenVariant : uint
+{
+    LIST_LR,                // Param list on the left, value on the right
+    LIST_LR_MULTI,          // As above, below the multi status bar
+    LIST_RLO,               // Value on the left, param list on the right
+    LIST_RLO_MULTI,         // As above, below the multi status bar
+    CHART_STD,              // EG/VCF chart only, value in the param value bar
+    CHART_LIST,             // Param list, EG/VCF chart and value below the chart
+    NUM_VARIANTS
+};
+
+// Param screen layout
+// Note: The value and tag sizes are only known at runtime, so the layout holds
+// the area the value is centred in, and the edges the value and tag are
+// aligned to
+struct ParamScreenLayout
+{
+    LayoutRect list;
+    LayoutRect chart;
+    LayoutRect value_area;
+    bool value_right_aligned;
+    int value_anchor_x;
+    int tag_anchor_x;
+
+    // Get the value rect for the specified value size
+    constexpr LayoutRect value_rect(int w, int h) const
+    {
+        return {(value_right_aligned ? (value_anchor_x - w) : value_anchor_x),
+                (value_area.y + ((value_area.height - h) / 2)), w, h};
+    }
+
+    // Get the tag rect (shown below the value) for the specified tag size -
+    // if left aligned, the tag is aligned to the right of the value if it is
+    // narrower than the value
+    constexpr LayoutRect tag_rect(const LayoutRect& value, int w, int h) const
+    {
+        return {(value_right_aligned ? (tag_anchor_x - w) :
+                    (w < value.width) ? (tag_anchor_x + value.width - w) : tag_anchor_x),
+                (value.y + value.height + 10), w, h};
+    }
+};
+
+// Param screen layout table builders
+constexpr ParamScreenLayout _param_list_screen_layout(bool left_right, bool multi_status_bar)
+{
+    int top = PARAM_LIST_MARGIN_TOP + (multi_status_bar ? (MULTI_STATUS_BAR_HEIGHT + 2) : 0);
+    int height = LIST_HEIGHT - (multi_status_bar ? (MULTI_STATUS_BAR_HEIGHT + 2) : 0);
+    LayoutRect list = {(left_right ? (int)LIST_MARGIN_LEFT : (int)(PARAM_VALUE_MARGIN_LEFT_RLO + PARAM_VALUE_WIDTH + PARAM_VALUE_MARGIN_RIGHT_RLO)),
+                       top, PARAM_LIST_WIDTH, height};
+    return {list, {0, 0, 0, 0}, list, left_right,
+            (left_right ? (int)(VISIBLE_LCD_WIDTH - PARAM_VALUE_MARGIN_LEFT) : (int)PARAM_VALUE_MARGIN_LEFT_RLO),
+            (left_right ? (int)(VISIBLE_LCD_WIDTH - 20) : (int)PARAM_VALUE_MARGIN_LEFT_RLO)};
+}
+
+constexpr ParamScreenLayout _param_chart_screen_layout(bool list)
+{
+    if (!list) {
+        return {{0, 0, 0, 0}, {EG_STD_MARGIN_LEFT, EG_STD_MARGIN_TOP, EG_STD_WIDTH, EG_STD_HEIGHT}, {0, 0, 0, 0}, true, 0, 0};
+    }
+    return {{LIST_MARGIN_LEFT, PARAM_LIST_MARGIN_TOP, PARAM_LIST_WIDTH, LIST_HEIGHT},
+            {EG_LST_MARGIN_LEFT, EG_LST_MARGIN_TOP, EG_LST_WIDTH, EG_LST_HEIGHT},
+            {0, (PARAM_LIST_MARGIN_TOP + (LIST_HEIGHT / 2)), PARAM_LIST_WIDTH, (LIST_HEIGHT / 2)},
+            true, (VISIBLE_LCD_WIDTH - PARAM_VALUE_MARGIN_LEFT), (VISIBLE_LCD_WIDTH - 20)};
+}
+
+// Param screen layout table, indexed by the param screen variant
+constexpr ParamScreenLayout PARAM_SCREEN_LAYOUTS[] = {
+    _param_list_screen_layout(true, false),
+    _param_list_screen_layout(true, true),
+    _param_list_screen_layout(false, false),
+    _param_list_screen_layout(false, true),
+    _param_chart_screen_layout(false),
+    _param_chart_screen_layout(true)
+};
+static_assert((sizeof(PARAM_SCREEN_LAYOUTS) / sizeof(ParamScreenLayout)) == (uint)ParamScreenVariant::NUM_VARIANTS,
+              "The param screen layout table must have an entry for each variant");
+
+// Param screen layout lookup functions
+constexpr ParamScreenVariant param_list_screen_variant(bool left_right, bool multi_status_bar)
+{
+    return left_right ?
+                (multi_status_bar ? ParamScreenVariant::LIST_LR_MULTI : ParamScreenVariant::LIST_LR) :
+                (multi_status_bar ? ParamScreenVariant::LIST_RLO_MULTI : ParamScreenVariant::LIST_RLO);
+}
+
+constexpr const ParamScreenLayout& param_screen_layout(ParamScreenVariant variant)
+{
+    return PARAM_SCREEN_LAYOUTS[(uint)variant];
+}
+
+// Param screen layout table check
+// The expected rects of each variant are literal screen coordinates, for a
+// 100x80 value with a narrower (60 pixel) and wider (150 pixel) tag below it
+// Note: An empty rect means the object is not positioned from the table for
+// that variant
+struct _ExpectedParamScreenLayout
+{
+    ParamScreenVariant variant;
+    LayoutRect list;
+    LayoutRect chart;
+    LayoutRect value;
+    LayoutRect narrow_tag;
+    LayoutRect wide_tag;
+};
+constexpr _ExpectedParamScreenLayout _EXPECTED_PARAM_SCREEN_LAYOUTS[] = {
+    {ParamScreenVariant::LIST_LR,        {9, 68, 422, 336},  {0, 0, 0, 0},       {734, 196, 100, 80}, {764, 286, 60, 36}, {674, 286, 150, 36}},
+    {ParamScreenVariant::LIST_LR_MULTI,  {9, 116, 422, 288}, {0, 0, 0, 0},       {734, 220, 100, 80}, {764, 310, 60, 36}, {674, 310, 150, 36}},
+    {ParamScreenVariant::LIST_RLO,       {431, 68, 422, 336}, {0, 0, 0, 0},      {19, 196, 100, 80},  {59, 286, 60, 36},  {19, 286, 150, 36}},
+    {ParamScreenVariant::LIST_RLO_MULTI, {431, 116, 422, 288}, {0, 0, 0, 0},     {19, 220, 100, 80},  {59, 310, 60, 36},  {19, 310, 150, 36}},
+    {ParamScreenVariant::CHART_STD,      {0, 0, 0, 0},       {122, 124, 600, 272}, {0, 0, 0, 0},      {0, 0, 0, 0},       {0, 0, 0, 0}},
+    {ParamScreenVariant::CHART_LIST,     {9, 68, 422, 336},  {441, 76, 402, 148}, {734, 280, 100, 80}, {0, 0, 0, 0},      {0, 0, 0, 0}}
+};
+
+constexpr bool _check_param_screen_layouts()
+{
+    // Check each variant against its expected rects
+    for (const auto& expected : _EXPECTED_PARAM_SCREEN_LAYOUTS) {
+        const auto& layout = param_screen_layout(expected.variant);
+        if (!(layout.list == expected.list) || !(layout.chart == expected.chart)) {
+            return false;
+        }
+        if (expected.value.width) {
+            auto value = layout.value_rect(100, 80);
+            if (!(value == expected.value)) {
+                return false;
+            }
+            if (expected.narrow_tag.width &&
+                (!(layout.tag_rect(value, 60, 36) == expected.narrow_tag) || !(layout.tag_rect(value, 150, 36) == expected.wide_tag))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+static_assert(_check_param_screen_layouts(), "The param screen layout table does not match the expected layouts");
+
+#endif  // SCREEN_LAYOUT_H
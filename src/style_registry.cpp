@@ -0,0 +1,171 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  style_registry.cpp
+ * @brief Style registry functions implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <map>
+#include <utility>
+#include <QFontDatabase>
+#include "style_registry.h"
+#include "gui_common.h"
+#include "utils.h"
+
+// Registered font - the font and its precomputed metrics
+struct RegisteredFont
+{
+    QFont font;
+    QFontMetrics metrics;
+
+    RegisteredFont(const QFont& f) : font(f), metrics(f) {}
+};
+
+// Constants
+constexpr uint NUM_LIST_ROW_PALETTES = 8;
+constexpr int LIST_ROW_BORDER_WIDTH = 1;
+constexpr int LIST_ROW_SEPARATOR_BORDER_WIDTH = 3;
+
+// Private variables
+// Note: std::map is used as references to its elements are never invalidated
+// by inserting new fonts
+std::map<std::pair<QString, uint>, RegisteredFont> _fonts;
+QString _css[(int)style_registry::Css::NUM_CSS];
+style_registry::ListRowPalette _list_row_palettes[NUM_LIST_ROW_PALETTES];
+QColor _list_background = Qt::black;
+
+// Private functions
+static const RegisteredFont& _font(const char *family, uint size);
+static inline uint _list_row_palette_index(bool selected, bool enabled, bool separator);
+static void _rebuild_list_row_palettes();
+
+//----------------------------------------------------------------------------
+// init
+//----------------------------------------------------------------------------
+void style_registry::init()
+{
+    // Add the Melbourne Instruments specific fonts
+    // Note: This must be done before any fonts are registered, so that their
+    // metrics are for the correct fonts
+    QFontDatabase::addApplicationFont(OCR_B_FONT_RES);
+    QFontDatabase::addApplicationFont(DSEG7_CLASSIC_FONT_RES);
+
+    // Build the style sheets for the current system colour
+    rebuild();
+}
+
+//----------------------------------------------------------------------------
+// rebuild
+//----------------------------------------------------------------------------
+void style_registry::rebuild()
+{
+    // Get the system colours
+    QString c = utils::get_css_system_colour_str();
+    QString d = utils::get_dimmed_css_system_colour_str();
+    auto css = [](Css id) -> QString& { return _css[(int)id]; };
+
+    // Rebuild each style sheet in the system colour
+    css(Css::LABEL) = "QLabel { color : " + c + "; }";
+    css(Css::LABEL_DIMMED) = "QLabel { color : " + d + "; }";
+    css(Css::LABEL_INVERTED) = "QLabel { background-color: " + c + "; color : black; }";
+    css(Css::LABEL_BLACK_BG) = "QLabel { background-color: black; color : " + c + "; }";
+    css(Css::LABEL_SYSTEM_BG) = "QLabel { background-color: " + c + "; }";
+    css(Css::PARAM_LIST) = "QListWidget { border: 0px; background-color: transparent; color : " + c + "; }";
+    css(Css::MAIN_LIST) = "QListView { background-color: " + _list_background.name() + "; color : " + c + "; }";
+    css(Css::MSG_BOX_BORDER) = "QLabel { background-color: black; border: 10px solid " + c + "; }";
+    css(Css::MSG_POPUP) = "QLabel { background-color: " + c + "; color : black; border: 40px solid black; }";
+
+    // Rebuild the list row palettes in the system colour
+    _rebuild_list_row_palettes();
+}
+
+//----------------------------------------------------------------------------
+// font
+//----------------------------------------------------------------------------
+const QFont& style_registry::font(const char *family, uint size)
+{
+    return _font(family, size).font;
+}
+
+//----------------------------------------------------------------------------
+// font_metrics
+//----------------------------------------------------------------------------
+const QFontMetrics& style_registry::font_metrics(const char *family, uint size)
+{
+    return _font(family, size).metrics;
+}
+
+//----------------------------------------------------------------------------
+// css
+//----------------------------------------------------------------------------
+const QString& style_registry::css(Css id)
+{
+    return _css[(int)id];
+}
+
+//----------------------------------------------------------------------------
+// list_row_palette
+//----------------------------------------------------------------------------
+const style_registry::ListRowPalette& style_registry::list_row_palette(bool selected, bool enabled, bool separator)
+{
+    return _list_row_palettes[_list_row_palette_index(selected, enabled, separator)];
+}
+
+//----------------------------------------------------------------------------
+// list_background
+//----------------------------------------------------------------------------
+const QColor& style_registry::list_background()
+{
+    // This is the background of the main list style sheet
+    return _list_background;
+}
+
+//----------------------------------------------------------------------------
+// _font
+//----------------------------------------------------------------------------
+static const RegisteredFont& _font(const char *family, uint size)
+{
+    // Create and register the font if this is the first time it has been used
+    auto key = std::make_pair(QString(family), size);
+    auto itr = _fonts.find(key);
+    if (itr == _fonts.end()) {
+        itr = _fonts.emplace(key, RegisteredFont(QFont(family, size))).first;
+    }
+    return itr->second;
+}
+
+//----------------------------------------------------------------------------
+// _list_row_palette_index
+//----------------------------------------------------------------------------
+static inline uint _list_row_palette_index(bool selected, bool enabled, bool separator)
+{
+    return (selected ? 0x01 : 0) | (enabled ? 0x02 : 0) | (separator ? 0x04 : 0);
+}
+
+//----------------------------------------------------------------------------
+// _rebuild_list_row_palettes
+//----------------------------------------------------------------------------
+static void _rebuild_list_row_palettes()
+{
+    QColor system_colour = utils::get_system_colour();
+    QColor dimmed_colour = utils::get_dimmed_system_colour_brush().color();
+
+    // Build the palette for each combination of row states
+    for (uint i=0; i<NUM_LIST_ROW_PALETTES; i++) {
+        bool selected = i & 0x01;
+        bool enabled = i & 0x02;
+        bool separator = i & 0x04;
+        auto& palette = _list_row_palettes[_list_row_palette_index(selected, enabled, separator)];
+
+        // Disabled rows show dimmed text, selected rows black text on the
+        // system colour
+        palette.text = !enabled ? dimmed_colour : (selected ? QColor(Qt::black) : system_colour);
+        palette.background = selected ? system_colour : QColor(Qt::transparent);
+
+        // Separator rows have a thicker dotted bottom border
+        palette.border = QPen((selected && separator) ? QColor(Qt::black) : system_colour);
+        palette.border.setWidth(separator ? LIST_ROW_SEPARATOR_BORDER_WIDTH : LIST_ROW_BORDER_WIDTH);
+        palette.border.setStyle(separator ? Qt::DotLine : Qt::SolidLine);
+    }
+}
@@ -0,0 +1,57 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  style_registry.h
+ * @brief Style registry functions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _STYLE_REGISTRY_H
+#define _STYLE_REGISTRY_H
+
+#include <QColor>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPen>
+#include <QString>
+
+namespace style_registry
+{
+    // Style sheets - C is the system colour, D the dimmed system colour
+    enum class Css
+    {
+        LABEL,                  // C text
+        LABEL_DIMMED,           // D text
+        LABEL_INVERTED,         // Black text on a C background
+        LABEL_BLACK_BG,         // C text on a black background
+        LABEL_SYSTEM_BG,        // C background
+        PARAM_LIST,
+        MAIN_LIST,
+        MSG_BOX_BORDER,
+        MSG_POPUP,
+        NUM_CSS
+    };
+
+    // List row palette - the colours used to paint a list row in one state
+    // Note: A transparent background means the row background is not filled
+    struct ListRowPalette
+    {
+        QColor text;
+        QColor background;
+        QPen border;
+    };
+
+    // Style registry functions
+    // Note: The fonts are created on first use and never destroyed, so the
+    // returned references remain valid for the life of the app. The registry
+    // should only be accessed from the GUI thread
+    void init();
+    void rebuild();
+    const QFont& font(const char *family, uint size);
+    const QFontMetrics& font_metrics(const char *family, uint size);
+    const QString& css(Css id);
+    const ListRowPalette& list_row_palette(bool selected, bool enabled, bool separator);
+    const QColor& list_background();
+}
+
+#endif  // _STYLE_REGISTRY_H
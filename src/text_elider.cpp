@@ -0,0 +1,142 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  text_elider.cpp
+ * @brief Text elision functions implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <QCache>
+#include <QFontMetrics>
+#include <QMutex>
+#include <QMutexLocker>
+#include "text_elider.h"
+
+// Constants
+constexpr char ELIDE_CHAR[]      = "~";
+constexpr int KEEP_EXT_NUM_CHARS = 3;
+constexpr int CACHE_MAX_ENTRIES  = 1024;
+
+// Elided text cache key
+struct CacheKey
+{
+    QString text;
+    QString font_key;
+    int max_width;
+    text_elider::ElideStyle style;
+
+    bool operator==(const CacheKey& other) const
+    {
+        return (max_width == other.max_width) && (style == other.style) &&
+               (text == other.text) && (font_key == other.font_key);
+    }
+};
+
+inline uint qHash(const CacheKey& key, uint seed=0)
+{
+    return qHash(key.text, seed) ^ qHash(key.font_key, seed) ^ qHash(key.max_width, seed) ^ qHash((int)key.style, seed);
+}
+
+// Private variables
+// Note: Each entry has a cost of 1, so the cache is bounded by the number
+// of entries. The cache is shared by the GUI thread and the GUI message
+// thread (which lays out the param screen), so is protected by a mutex
+QMutex _cache_mutex;
+QCache<CacheKey, text_elider::ElidedText> _cache(CACHE_MAX_ENTRIES);
+uint _cache_hits = 0;
+uint _cache_misses = 0;
+
+// Private functions
+static text_elider::ElidedText _elide(const QString& text, const QFont& font, int max_width, text_elider::ElideStyle style);
+
+//----------------------------------------------------------------------------
+// elide
+//----------------------------------------------------------------------------
+text_elider::ElidedText text_elider::elide(const QString& text, const QFont& font, int max_width, ElideStyle style)
+{
+    // Has this text already been elided for this font, width and style?
+    // If so, skip the measurement and return the cached text
+    CacheKey key = {text, font.key(), max_width, style};
+    {
+        QMutexLocker lock(&_cache_mutex);
+        auto cached = _cache.object(key);
+        if (cached) {
+            _cache_hits++;
+            return *cached;
+        }
+        _cache_misses++;
+    }
+
+    // Elide the text and cache it
+    // Note: The text is measured outside of the lock
+    auto elided = _elide(text, font, max_width, style);
+    QMutexLocker lock(&_cache_mutex);
+    _cache.insert(key, new ElidedText(elided));
+    return elided;
+}
+
+//----------------------------------------------------------------------------
+// cache_stats
+//----------------------------------------------------------------------------
+text_elider::CacheStats text_elider::cache_stats()
+{
+    // Return the cache statistics
+    QMutexLocker lock(&_cache_mutex);
+    return {_cache_hits, _cache_misses, (uint)_cache.count()};
+}
+
+//----------------------------------------------------------------------------
+// clear_cache
+//----------------------------------------------------------------------------
+void text_elider::clear_cache()
+{
+    // Clear the cache and reset the statistics
+    QMutexLocker lock(&_cache_mutex);
+    _cache.clear();
+    _cache_hits = 0;
+    _cache_misses = 0;
+}
+
+//----------------------------------------------------------------------------
+// _elide
+//----------------------------------------------------------------------------
+static text_elider::ElidedText _elide(const QString& text, const QFont& font, int max_width, text_elider::ElideStyle style)
+{
+    QFontMetrics fm(font);
+
+    // If the text fits (or there is no max width), return it as is
+    int width = fm.horizontalAdvance(text);
+    if ((max_width == -1) || (width <= max_width)) {
+        return {text, width};
+    }
+
+    // Split the text into the part that can be truncated, and the part that
+    // is always kept after the elide character
+    QString head = text;
+    QString tail = ELIDE_CHAR;
+    if ((style == text_elider::ElideStyle::MIDDLE_KEEP_EXT) && (text.size() > KEEP_EXT_NUM_CHARS)) {
+        head = text.left(text.size() - KEEP_EXT_NUM_CHARS);
+        tail += text.right(KEEP_EXT_NUM_CHARS);
+    }
+
+    // The width increases with the number of head characters kept, so binary
+    // search for the longest head that fits - at least one character is always
+    // removed
+    int tail_width = fm.horizontalAdvance(tail);
+    int lo = 0;
+    int hi = head.size() - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if ((fm.horizontalAdvance(head.left(mid)) + tail_width) <= max_width) {
+            lo = mid;
+        }
+        else {
+            hi = mid - 1;
+        }
+    }
+
+    // Return the elided text
+    // Note: If even the tail doesn't fit, it is returned on its own
+    QString elided = head.left(lo) + tail;
+    return {elided, fm.horizontalAdvance(elided)};
+}
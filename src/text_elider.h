@@ -0,0 +1,46 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  text_elider.h
+ * @brief Text elision functions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _TEXT_ELIDER_H
+#define _TEXT_ELIDER_H
+
+#include <QFont>
+#include <QString>
+
+namespace text_elider
+{
+    // Elision style
+    enum class ElideStyle
+    {
+        RIGHT,              // "long nam~"
+        MIDDLE_KEEP_EXT     // "long n~ame" - the last 3 characters are kept
+    };
+
+    // Elided text - the display text and its width in pixels
+    struct ElidedText
+    {
+        QString text;
+        int width;
+    };
+
+    // Elided text cache statistics
+    struct CacheStats
+    {
+        uint hits;
+        uint misses;
+        uint num_entries;
+    };
+
+    // Text elision functions
+    // Note: A max width of -1 means the text is never elided
+    ElidedText elide(const QString& text, const QFont& font, int max_width, ElideStyle style=ElideStyle::RIGHT);
+    CacheStats cache_stats();
+    void clear_cache();
+}
+
+#endif  // _TEXT_ELIDER_H
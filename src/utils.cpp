@@ -20,6 +20,8 @@ constexpr char DEFAULT_SYSTEM_COLOUR[] = "FFFFFF";
 // Private variables
 QColor _system_colour;
 QString _system_colour_str;
+bool _wt_waterfall_view = false;
+bool _param_value_shrink_to_fit = true;
 
 
 //----------------------------------------------------------------------------
@@ -48,6 +50,18 @@ void utils::init()
             // Get the system colour string
             colour_str = val.toString();            
         }
+
+        // Get the wavetable view (optional)
+        val = obj.value(QString("wt_waterfall_view"));
+        if ((val != QJsonValue::Undefined) && val.isBool()) {
+            _wt_waterfall_view = val.toBool();
+        }
+
+        // Get the param value fit mode (optional)
+        val = obj.value(QString("param_value_shrink_to_fit"));
+        if ((val != QJsonValue::Undefined) && val.isBool()) {
+            _param_value_shrink_to_fit = val.toBool();
+        }
     }
 
     // Set the system colour
@@ -150,3 +164,19 @@ QPixmap utils::set_pixmap_to_system_colour(const QPixmap& pixmap)
     }
     return QPixmap::fromImage(tmp);
 }
+
+//----------------------------------------------------------------------------
+// get_wt_waterfall_view
+//----------------------------------------------------------------------------
+bool utils::get_wt_waterfall_view()
+{
+    return _wt_waterfall_view;
+}
+
+//----------------------------------------------------------------------------
+// get_param_value_shrink_to_fit
+//----------------------------------------------------------------------------
+bool utils::get_param_value_shrink_to_fit()
+{
+    return _param_value_shrink_to_fit;
+}
@@ -24,6 +24,8 @@ namespace utils
     QBrush get_dimmed_system_colour_brush(uint intensity=5);
     void set_system_colour(const char *colour_str);
     QPixmap set_pixmap_to_system_colour(const QPixmap& pixmap);
+    bool get_wt_waterfall_view();
+    bool get_param_value_shrink_to_fit();
 }
 
 #endif  // _UTILS_H
@@ -6,27 +6,33 @@
  * @brief Bottom Bar class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <QPainter>
+#include <QPaintEvent>
 #include "bottom_bar.h"
+#include "style_registry.h"
 #include "utils.h"
 
 // Constants
 constexpr uint SOFT_BUTTON_FONT_SIZE = 32;
-constexpr uint SOFT_BUTTON_WIDTH     = 281;
+constexpr int TOP_BORDER_SIZE        = 2;
+constexpr int BUTTON_BORDER_SIZE     = 1;
 
 //----------------------------------------------------------------------------
 // BottomBar
 //----------------------------------------------------------------------------
 BottomBar::BottomBar(QWidget *parent) : MoniqLabel(parent)
 {
-    // Create the soft button objects
-    _soft_button1 = new MoniqLabel(parent);
-    _soft_button1->setFont(QFont(STANDARD_FONT_NAME, SOFT_BUTTON_FONT_SIZE));
-    _soft_button1->setAlignment(Qt::AlignTop|Qt::AlignHCenter);
-    _soft_button1->setText("----");
-    _soft_button2 = new MoniqLabel(parent);
-    _soft_button2->setFont(QFont(STANDARD_FONT_NAME, SOFT_BUTTON_FONT_SIZE));
-    _soft_button2->setAlignment(Qt::AlignTop|Qt::AlignHCenter);
-    _soft_button2->setText("----");
+    // The bar paints every pixel itself
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setFont(style_registry::font(STANDARD_FONT_NAME, SOFT_BUTTON_FONT_SIZE));
+
+    // Lay out the initial soft button text
+    _soft_button1.setTextFormat(Qt::PlainText);
+    _soft_button1.setText("----");
+    _soft_button1.prepare(QTransform(), font());
+    _soft_button2.setTextFormat(Qt::PlainText);
+    _soft_button2.setText("----");
+    _soft_button2.prepare(QTransform(), font());
     _soft_button1_state = false;
     _soft_button2_state = false;
 
@@ -35,33 +41,20 @@ BottomBar::BottomBar(QWidget *parent) : MoniqLabel(parent)
     show();
 }
 
-//----------------------------------------------------------------------------
-// setGeometry
-//----------------------------------------------------------------------------
-void BottomBar::setGeometry(int x, int y, int w, int h)
-{
-    int button_width = w / 2;
-
-    // Set the status bar geometry
-    MoniqLabel::setGeometry(x, y, w, h);
-
-    // Set the soft button geometry
-    _soft_button1->setGeometry (x, y, button_width, h);
-    _soft_button2->setGeometry ((x + w - button_width), y, button_width, h);
-}
-
 //----------------------------------------------------------------------------
 // set_soft_button_text
 //----------------------------------------------------------------------------
 void BottomBar::set_soft_button_text(SoftButtonId id, const QString& text)
 {
-    MoniqLabel *soft_button = id == SoftButtonId::BUTTON_1 ? _soft_button1 : _soft_button2;
+    QStaticText& soft_button = id == SoftButtonId::BUTTON_1 ? _soft_button1 : _soft_button2;
+    QString button_text = text.size() > 0 ? text : "----";
 
-    // Set the soft button text
-    if (text.size() > 0)
-        soft_button->setText(text);
-    else
-        soft_button->setText("----");
+    // Set the soft button text, if it has changed
+    if (button_text != soft_button.text()) {
+        soft_button.setText(button_text);
+        soft_button.prepare(QTransform(), font());
+        update(_soft_button_rect(id));
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -72,17 +65,10 @@ void BottomBar::set_soft_button_state(SoftButtonId id, int state)
     // If we should update this button state
     if (state != -1) {
         // Update the soft button state depending if pressed or not
-        if (state) {
-            id == SoftButtonId::BUTTON_1 ? _soft_button1_state = true : _soft_button2_state = true;
-            id == SoftButtonId::BUTTON_1 ?
-                _soft_button1->setStyleSheet("QLabel { color: black; background-color: " + utils::get_css_system_colour_str() + "; border-top: 2px solid " + utils::get_css_system_colour_str() + "; border-right: 1px solid " + utils::get_css_system_colour_str() + ";}") :
-                _soft_button2->setStyleSheet("QLabel { color: black; background-color: " + utils::get_css_system_colour_str() + "; border-top: 2px solid " + utils::get_css_system_colour_str() + "; border-left: 1px solid " + utils::get_css_system_colour_str() + ";}");
-        }
-        else {
-            id == SoftButtonId::BUTTON_1 ? _soft_button1_state = false : _soft_button2_state = false;
-            id == SoftButtonId::BUTTON_1 ?
-                _soft_button1->setStyleSheet("QLabel { color: " + utils::get_css_system_colour_str() + "; background-color: black; border-top: 2px solid " + utils::get_css_system_colour_str() + "; border-right: 1px solid " + utils::get_css_system_colour_str() + ";}") :
-                _soft_button2->setStyleSheet("QLabel { color: " + utils::get_css_system_colour_str() + "; background-color: black; border-top: 2px solid " + utils::get_css_system_colour_str() + "; border-left: 1px solid " + utils::get_css_system_colour_str() + ";}");                          
+        bool& soft_button_state = id == SoftButtonId::BUTTON_1 ? _soft_button1_state : _soft_button2_state;
+        if (soft_button_state != (state != 0)) {
+            soft_button_state = (state != 0);
+            update(_soft_button_rect(id));
         }
     }
 }
@@ -92,8 +78,48 @@ void BottomBar::set_soft_button_state(SoftButtonId id, int state)
 //----------------------------------------------------------------------------
 void BottomBar::refresh_colour()
 {
-    // Refresh the bottom bar object colours
-    setStyleSheet("QLabel { color: " + utils::get_css_system_colour_str() + "; background-color: black; border-top: 2px solid " + utils::get_css_system_colour_str() + ";}");
-    set_soft_button_state(SoftButtonId::BUTTON_1, _soft_button1_state);
-    set_soft_button_state(SoftButtonId::BUTTON_2, _soft_button2_state);
+    // The colours are read when painting, so just repaint the bottom bar
+    update();
+}
+
+//----------------------------------------------------------------------------
+// paintEvent
+//----------------------------------------------------------------------------
+void BottomBar::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    QColor system_colour = utils::get_system_colour();
+
+    // Draw each soft button that needs repainting
+    painter.setFont(font());
+    for (auto id : {SoftButtonId::BUTTON_1, SoftButtonId::BUTTON_2}) {
+        auto rect = _soft_button_rect(id);
+        if (!event->rect().intersects(rect)) {
+            continue;
+        }
+        bool button1 = (id == SoftButtonId::BUTTON_1);
+        bool pressed = button1 ? _soft_button1_state : _soft_button2_state;
+        const QStaticText& text = button1 ? _soft_button1 : _soft_button2;
+
+        // Draw the button background and borders - the border between the two
+        // buttons is on the inside edge of each button
+        painter.fillRect(rect, (pressed ? system_colour : QColor(Qt::black)));
+        painter.fillRect(rect.x(), rect.y(), rect.width(), TOP_BORDER_SIZE, system_colour);
+        painter.fillRect((button1 ? (rect.right() + 1 - BUTTON_BORDER_SIZE) : rect.x()), rect.y(), BUTTON_BORDER_SIZE, rect.height(), system_colour);
+
+        // Draw the button text at the top of the button, horizontally centred
+        // within the borders
+        auto text_rect = rect.adjusted((button1 ? 0 : BUTTON_BORDER_SIZE), TOP_BORDER_SIZE, (button1 ? -BUTTON_BORDER_SIZE : 0), 0);
+        painter.setPen(pressed ? QColor(Qt::black) : system_colour);
+        painter.drawStaticText((text_rect.x() + ((text_rect.width() - text.size().width()) / 2)), text_rect.y(), text);
+    }
+}
+
+//----------------------------------------------------------------------------
+// _soft_button_rect
+//----------------------------------------------------------------------------
+QRect BottomBar::_soft_button_rect(SoftButtonId id) const
+{
+    int button_width = width() / 2;
+    return QRect(((id == SoftButtonId::BUTTON_1) ? 0 : (width() - button_width)), 0, button_width, height());
 }
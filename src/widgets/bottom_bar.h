@@ -9,12 +9,15 @@
 #ifndef BOTTOM_BAR_H
 #define BOTTOM_BAR_H
 
+#include <QStaticText>
 #include <QString>
 #include "gui_common.h"
 #include "gui_msg.h"
 #include "moniq_label.h"
 
 // Bottom Bar class
+// The bar is painted by the widget itself from the pre-laid out soft button
+// text, so a soft button change only repaints that button
 class BottomBar: public MoniqLabel
 {
     Q_OBJECT
@@ -22,20 +25,24 @@ public:
     // Constructors
     explicit BottomBar(QWidget *parent = nullptr);
 
-    // Overriden functions
-    void setGeometry(int x, int y, int w, int h);
-
     // Public functions
     void set_soft_button_text(SoftButtonId id, const QString& text);
     void set_soft_button_state(SoftButtonId id, int state);
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     // Private data
-    MoniqLabel *_soft_button1;
-    MoniqLabel *_soft_button2;
+    QStaticText _soft_button1;
+    QStaticText _soft_button2;
     bool _soft_button1_state;
     bool _soft_button2_state;
+
+    // Private functions
+    QRect _soft_button_rect(SoftButtonId id) const;
 };
 
 #endif
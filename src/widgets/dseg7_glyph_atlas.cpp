@@ -0,0 +1,204 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  dseg7_glyph_atlas.cpp
+ * @brief DSEG7 Glyph Atlas class implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <QFontMetrics>
+#include "dseg7_glyph_atlas.h"
+#include "gui_common.h"
+
+// Constants
+constexpr char ATLAS_GLYPHS[]   = "0123456789+-.:% ~";
+constexpr char ELIDE_CHAR       = '~';
+constexpr int GLYPH_PADDING     = 2;
+
+//----------------------------------------------------------------------------
+// Dseg7GlyphAtlas
+//----------------------------------------------------------------------------
+Dseg7GlyphAtlas::Dseg7GlyphAtlas(uint font_size) : _font(PARAM_VALUE_FONT_NAME, font_size)
+{
+    // Note: The atlas creates its own font rather than sharing one from the
+    // style registry, as the registry fonts must only be used from the GUI
+    // thread
+    QFontMetrics fm(_font);
+
+    // Get the glyph positions in the atlas - only glyphs in the font are added
+    // Note: The glyphs are italic, so the bounding rect of each glyph is used
+    // rather than its advance to allow for any overhang
+    int x = 0;
+    _ascent = fm.ascent();
+    _height = fm.height();
+    for (const char *c=ATLAS_GLYPHS; *c; c++) {
+        auto& glyph = _glyphs[(uint)*c];
+        if (fm.inFont(QChar(*c))) {
+            auto br = fm.boundingRect(QChar(*c));
+            glyph.valid = true;
+            glyph.left = br.left();
+            glyph.advance = fm.horizontalAdvance(QChar(*c));
+            glyph.src = QRect(x, 0, br.width() + GLYPH_PADDING, _height);
+            x += glyph.src.width();
+        }
+    }
+    _atlas_width = x;
+}
+
+//----------------------------------------------------------------------------
+// render
+//----------------------------------------------------------------------------
+void Dseg7GlyphAtlas::render(const QColor& colour)
+{
+    // Render the atlas glyphs in the specified colour
+    // Note: The pixmap is only created here, so an atlas that is never
+    // rendered can be used to measure values from any thread
+    _atlas = render_glyphs(colour);
+}
+
+//----------------------------------------------------------------------------
+// render_glyphs
+//----------------------------------------------------------------------------
+QPixmap Dseg7GlyphAtlas::render_glyphs(const QColor& colour) const
+{
+    // Render each glyph into a pixmap in the specified colour
+    QPixmap glyphs(_atlas_width, _height);
+    glyphs.fill(Qt::transparent);
+    QPainter painter(&glyphs);
+    painter.setFont(_font);
+    painter.setPen(colour);
+    for (const char *c=ATLAS_GLYPHS; *c; c++) {
+        auto& glyph = _glyphs[(uint)*c];
+        if (glyph.valid) {
+            painter.drawText((glyph.src.x() - glyph.left), _ascent, QString(QChar(*c)));
+        }
+    }
+    return glyphs;
+}
+
+//----------------------------------------------------------------------------
+// font
+//----------------------------------------------------------------------------
+const QFont& Dseg7GlyphAtlas::font() const
+{
+    return _font;
+}
+
+//----------------------------------------------------------------------------
+// height
+//----------------------------------------------------------------------------
+int Dseg7GlyphAtlas::height() const
+{
+    return _height;
+}
+
+//----------------------------------------------------------------------------
+// contains
+//----------------------------------------------------------------------------
+bool Dseg7GlyphAtlas::contains(const QString& text) const
+{
+    // Check every character of the text is in the atlas
+    for (auto c : text) {
+        if (!_glyph(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// text_width
+//----------------------------------------------------------------------------
+int Dseg7GlyphAtlas::text_width(const QString& text) const
+{
+    // The width is the sum of the glyph advances, plus any overhang of the
+    // last glyph
+    // Note: Assumes the text only contains glyphs in the atlas
+    int width = 0;
+    const Glyph *glyph = nullptr;
+    for (auto c : text) {
+        glyph = _glyph(c);
+        width += glyph->advance;
+    }
+    if (glyph) {
+        int overhang = (glyph->left + glyph->src.width() - GLYPH_PADDING) - glyph->advance;
+        if (overhang > 0) {
+            width += overhang;
+        }
+    }
+    return width;
+}
+
+//----------------------------------------------------------------------------
+// glyph_rect
+//----------------------------------------------------------------------------
+QRect Dseg7GlyphAtlas::glyph_rect(const QString& text, int index) const
+{
+    // Get the area drawn by the glyph at the specified index, relative to
+    // the position the text is drawn at
+    // Note: Assumes the text only contains glyphs in the atlas
+    int x = 0;
+    for (int i=0; i<index; i++) {
+        x += _glyph(text[i])->advance;
+    }
+    auto glyph = _glyph(text[index]);
+    return QRect((x + glyph->left), 0, glyph->src.width(), _height);
+}
+
+//----------------------------------------------------------------------------
+// elide
+//----------------------------------------------------------------------------
+QString Dseg7GlyphAtlas::elide(const QString& text, int max_width) const
+{
+    // If the text fits (or there is no max width), return it as is
+    if ((max_width == -1) || (text_width(text) <= max_width)) {
+        return text;
+    }
+
+    // Find the longest prefix that fits with the elide character - at least
+    // one character is always removed
+    // Note: If the elide character isn't in the font, the text is just truncated
+    QString tail = _glyph(ELIDE_CHAR) ? QString(QChar(ELIDE_CHAR)) : QString();
+    int tail_width = text_width(tail);
+    int width = 0;
+    int n = 0;
+    while ((n < (text.size() - 1)) && ((width + _glyph(text[n])->advance + tail_width) <= max_width)) {
+        width += _glyph(text[n])->advance;
+        n++;
+    }
+    return text.left(n) + tail;
+}
+
+//----------------------------------------------------------------------------
+// draw
+//----------------------------------------------------------------------------
+void Dseg7GlyphAtlas::draw(QPainter& painter, int x, int y, const QString& text) const
+{
+    // Blit each glyph from the rendered atlas
+    draw(painter, _atlas, x, y, text);
+}
+
+//----------------------------------------------------------------------------
+// draw
+//----------------------------------------------------------------------------
+void Dseg7GlyphAtlas::draw(QPainter& painter, const QPixmap& glyphs, int x, int y, const QString& text) const
+{
+    // Blit each glyph from the glyph pixmap - this must have been rendered
+    // from this atlas
+    // Note: Assumes the text only contains glyphs in the atlas
+    for (auto c : text) {
+        auto glyph = _glyph(c);
+        painter.drawPixmap((x + glyph->left), y, glyphs, glyph->src.x(), glyph->src.y(), glyph->src.width(), glyph->src.height());
+        x += glyph->advance;
+    }
+}
+
+//----------------------------------------------------------------------------
+// _glyph
+//----------------------------------------------------------------------------
+const Dseg7GlyphAtlas::Glyph *Dseg7GlyphAtlas::_glyph(QChar c) const
+{
+    // Return the glyph if it is in the atlas
+    auto u = c.unicode();
+    return ((u < 128) && _glyphs[u].valid) ? &_glyphs[u] : nullptr;
+}
@@ -0,0 +1,65 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  dseg7_glyph_atlas.h
+ * @brief DSEG7 Glyph Atlas class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef DSEG7_GLYPH_ATLAS_H
+#define DSEG7_GLYPH_ATLAS_H
+
+#include <QColor>
+#include <QFont>
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+// DSEG7 Glyph Atlas class
+// Pre-renders the DSEG7 digits, signs and punctuation into a single pixmap,
+// so that values can be drawn by blitting glyphs, and measured from the
+// glyph advances without a text layout pass
+// Owners that share an atlas (for example with a metrics object) can render
+// their own glyph pixmap from it, and draw from that pixmap
+class Dseg7GlyphAtlas
+{
+public:
+    // Constructor
+    Dseg7GlyphAtlas(uint font_size);
+
+    // Public functions
+    void render(const QColor& colour);
+    QPixmap render_glyphs(const QColor& colour) const;
+    const QFont& font() const;
+    int height() const;
+    bool contains(const QString& text) const;
+    int text_width(const QString& text) const;
+    QRect glyph_rect(const QString& text, int index) const;
+    QString elide(const QString& text, int max_width) const;
+    void draw(QPainter& painter, int x, int y, const QString& text) const;
+    void draw(QPainter& painter, const QPixmap& glyphs, int x, int y, const QString& text) const;
+
+private:
+    // Glyph - the position in the atlas, and the offset and advance when drawn
+    struct Glyph
+    {
+        bool valid;
+        QRect src;
+        int left;
+        int advance;
+    };
+
+    // Private data
+    QFont _font;
+    QPixmap _atlas;
+    Glyph _glyphs[128] = {};
+    int _atlas_width;
+    int _ascent;
+    int _height;
+
+    // Private functions
+    const Glyph *_glyph(QChar c) const;
+};
+
+#endif  // DSEG7_GLYPH_ATLAS_H
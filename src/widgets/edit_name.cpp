@@ -6,8 +6,11 @@
  * @brief Edit Name widget class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <QPainter>
+#include <QPaintEvent>
 #include "edit_name.h"
 #include "gui_common.h"
+#include "style_registry.h"
 #include "utils.h"
 
 // Constants
@@ -15,29 +18,14 @@ constexpr uint EDIT_NAME_FONT_SIZE      = 32;
 constexpr uint EDIT_NAME_SEL_CHAR_WIDTH = 32;
 constexpr uint EDIT_NAME_CHAR_WIDTH     = 24;
 constexpr uint EDIT_NAME_CHAR_HEIGHT    = 44;
+constexpr uint EDIT_NAME_ROW            = 3;
+constexpr uint ASCII_PICKER_SEL_ROW     = 3;
 
 //----------------------------------------------------------------------------
 // EditName
 //----------------------------------------------------------------------------
 EditName::EditName(QWidget *parent) : MoniqLabel(parent)
 {
-    // Create the Edit Name object (array of labels)
-    for (uint i=0; i<EDIT_NAME_STR_LEN; i++) {
-        // Create the character object - note the edit name is shown in the middle of the
-        // ASCII picker
-        _edit_name[i] = new QLabel(parent);
-        _edit_name[i]->setFont(QFont(STANDARD_FONT_NAME, EDIT_NAME_FONT_SIZE));
-        _edit_name[i]->setAlignment(Qt::AlignCenter);
-    }
-
-    // Create the ASCII picker object (array of labels)
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++) {
-        // Create the character object
-        _ascii_picker[i] = new QLabel(parent);
-        _ascii_picker[i]->setFont(QFont(STANDARD_FONT_NAME, EDIT_NAME_FONT_SIZE));
-        _ascii_picker[i]->setAlignment(Qt::AlignCenter);
-    }
-
     // Create an array of ASCII characters we are allowed to display when editing a name
     // Add 0-9 and A-Z only
     uint j=0;
@@ -50,11 +38,24 @@ EditName::EditName(QWidget *parent) : MoniqLabel(parent)
     }
     _ascii_chars[j] = '-';
 
+    // Map each ASCII character to its position in the glyph strips
+    for (uint i=0; i<128; i++) {
+        _glyph_index[i] = -1;
+    }
+    for (uint i=0; i<NUM_ASCII_CHARS; i++) {
+        _glyph_index[(uint)_ascii_chars[i]] = i;
+    }
+
     // Initialise other variables
     _selected_char = -1;
+    _hidden_char = -1;
+    _dim_after_selected = false;
+    _picker_char = -1;
+    _left_margin = 0;
+    _top_margin = 0;
 
     // Set the initial colour
-    setStyleSheet("QLabel { background-color: black; }");
+    setFont(style_registry::font(STANDARD_FONT_NAME, EDIT_NAME_FONT_SIZE));
     refresh_colour();
     hide();
 }
@@ -64,36 +65,11 @@ EditName::EditName(QWidget *parent) : MoniqLabel(parent)
 //----------------------------------------------------------------------------
 void EditName::setGeometry(int x, int y, int w, int h)
 {
-    uint left_margin = x + (w - ((EDIT_NAME_STR_LEN - 1) * EDIT_NAME_CHAR_WIDTH) - EDIT_NAME_SEL_CHAR_WIDTH) / 2;
-    uint top_margin = y + (h - (ASCII_PICKER_SIZE * EDIT_NAME_CHAR_HEIGHT)) / 2;
-
-    // Set the overall edit name geometry
+    // Set the overall edit name geometry, and the margins for the name
+    // and ASCII picker within it
     MoniqLabel::setGeometry(x, y, w, h);
-
-    // Set the geometry for each edit name character
-    uint x_offset = left_margin;
-    uint y_offset = top_margin;
-    uint width = EDIT_NAME_SEL_CHAR_WIDTH;
-    for (uint i=0; i<EDIT_NAME_STR_LEN; i++)  {
-        // Set the edit name characters geometry
-        uint width = (i == 0 ? EDIT_NAME_SEL_CHAR_WIDTH : EDIT_NAME_CHAR_WIDTH);
-        _edit_name[i]->setGeometry(x_offset, 
-                                   (y_offset + (EDIT_NAME_CHAR_HEIGHT * 3)),
-                                   width,
-                                   EDIT_NAME_CHAR_HEIGHT);
-        x_offset += width;   
-    }
-
-    // Set the geometry for each ASCII picker character
-    x_offset = left_margin;
-    y_offset = top_margin;
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++) {
-        _ascii_picker[i]->setGeometry(x_offset, 
-                                      y_offset,
-                                      EDIT_NAME_SEL_CHAR_WIDTH,
-                                      EDIT_NAME_CHAR_HEIGHT);
-        y_offset += EDIT_NAME_CHAR_HEIGHT;
-    }
+    _left_margin = (w - ((EDIT_NAME_STR_LEN - 1) * EDIT_NAME_CHAR_WIDTH) - EDIT_NAME_SEL_CHAR_WIDTH) / 2;
+    _top_margin = (h - (ASCII_PICKER_SIZE * EDIT_NAME_CHAR_HEIGHT)) / 2;
 }
 
 //----------------------------------------------------------------------------
@@ -102,12 +78,11 @@ void EditName::setGeometry(int x, int y, int w, int h)
 void EditName::hide()
 {
     // Hide the Edit Name and ASCII Picker
-    for (uint i=0; i<EDIT_NAME_STR_LEN; i++)
-        _edit_name[i]->hide();
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++)
-        _ascii_picker[i]->hide();
     MoniqLabel::hide();
+    _name.clear();
     _selected_char = -1;
+    _hidden_char = -1;
+    _picker_char = -1;
 }
 
 //----------------------------------------------------------------------------
@@ -117,42 +92,18 @@ void EditName::show_edit_name(const QString& name)
 {
     // Has a selected character been specified?
     if (_selected_char == -1) {
-        int x_offset = _edit_name[0]->x();
-        int width;
-
-        // Always select one following the last character
+        // Always select one following the last character, with no
+        // characters dimmed
         _selected_char = (name.size() < EDIT_NAME_STR_LEN) ? name.size() : (EDIT_NAME_STR_LEN-1);
-
-        // Set the style for each character in the name
-        for (uint i=0; i<EDIT_NAME_STR_LEN; i++) {
-            // Highlight the selected character
-            if (i == (uint)_selected_char) {
-                _edit_name[i]->setStyleSheet("QLabel { background-color:  " + utils::get_css_system_colour_str() + "; color : black; }");
-                width = EDIT_NAME_SEL_CHAR_WIDTH;
-            }
-            else {
-                _edit_name[i]->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
-                width = EDIT_NAME_CHAR_WIDTH;
-            }
-
-            // Set the character geometry
-            _edit_name[i]->setGeometry (x_offset, (_ascii_picker[0]->y() + (EDIT_NAME_CHAR_HEIGHT * 3)), width, EDIT_NAME_CHAR_HEIGHT);
-            x_offset += width;            
-        }
+        _dim_after_selected = false;
     }
 
-    // Set the name text
-    uint i = 0;
-    for (; i<name.size(); i++) {
-        // Show each character in the name
-        _edit_name[i]->setText(name.at(i));
-        _edit_name[i]->show();
-    }
-    _edit_name[i]->setText(" ");
-    _edit_name[i]->show();
-
-    // Set the ASCII picker geometry
-    _set_ascii_picker_geometry();   
+    // Set the name text, followed by a space, and hide the ASCII picker
+    _name = name.left(EDIT_NAME_STR_LEN - 1) + ' ';
+    _hidden_char = -1;
+    _picker_char = -1;
+    update(_name_rect() | _picker_rect());
+    show();
 }
 
 //----------------------------------------------------------------------------
@@ -160,36 +111,15 @@ void EditName::show_edit_name(const QString& name)
 //----------------------------------------------------------------------------
 void EditName::select_edit_name_char(uint index)
 {
-    int x_offset = _edit_name[0]->x();
-    int width;
+    // Repaint the ASCII picker at its old position, as it is hidden
+    update(_picker_rect());
 
-    // Process each character in the edit name
+    // Select the character - the characters following it are now dimmed
+    // Note: The selected character is wider, so the whole name is repainted
     _selected_char = index;
-    for (uint i=0; i<EDIT_NAME_STR_LEN; i++)  {
-        // Is this the selected character?
-        if (i == _selected_char) {
-            // Highlight it and set the selected character width
-            _edit_name[i]->setStyleSheet("QLabel { background-color:  " + utils::get_css_system_colour_str() + "; color : black; }");
-            width = EDIT_NAME_SEL_CHAR_WIDTH;
-        }
-        else if (i < _selected_char) {
-            // Show the character normally
-            _edit_name[i]->setStyleSheet("QLabel { color : " + utils::get_css_system_colour_str() + "; }");
-            width = EDIT_NAME_CHAR_WIDTH;
-        }
-        else {
-            // Show a dimmed character
-            _edit_name[i]->setStyleSheet("QLabel { color : " + utils::get_dimmed_css_system_colour_str() + "; }");
-            width = EDIT_NAME_CHAR_WIDTH;            
-        }
-
-        // Set the character geometry
-        _edit_name[i]->setGeometry (x_offset, (_ascii_picker[0]->y() + (EDIT_NAME_CHAR_HEIGHT * 3)), width, EDIT_NAME_CHAR_HEIGHT);
-        x_offset += width;
-    }
-    
-    // Set the ASCII picker geometry
-    _set_ascii_picker_geometry();
+    _dim_after_selected = true;
+    _picker_char = -1;
+    update(_name_rect());
 }
 
 //----------------------------------------------------------------------------
@@ -202,74 +132,147 @@ void EditName::change_edit_name_char(uint char_index)
     if (char_index > (NUM_ASCII_CHARS - 1))
         char_index = 1;
     
-    // Hide the selected character in the name
-    _edit_name[_selected_char]->setVisible(false);
+    // Hide the selected character in the name, and show the ASCII picker
+    // centred on the character
+    _hidden_char = _selected_char;
+    _picker_char = char_index;
+    update(_picker_rect());
+}
 
-    // Set the ASCII chars to show in the list
-    int index = char_index - 3;
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++)
-    {
-        // If the index can be used to show a character
-        if ((index >=0) && (index < (int)NUM_ASCII_CHARS)) {
-            // Set the list item character and show it
-            std::string str;
-            str = _ascii_chars[index];
-            _ascii_picker[i]->setText(str.c_str());
-            _ascii_picker[i]->show();
+//----------------------------------------------------------------------------
+// refresh_colour
+//----------------------------------------------------------------------------
+void EditName::refresh_colour()
+{
+    // Re-render the glyph strips in the system colour
+    _render_glyph_strips();
+    update();
+}
+
+//----------------------------------------------------------------------------
+// paintEvent
+//----------------------------------------------------------------------------
+void EditName::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+
+    // Clear the area being repainted
+    painter.fillRect(event->rect(), Qt::black);
+    if (_selected_char == -1) {
+        return;
+    }
+
+    // Draw the name characters that need repainting
+    for (uint i=0; i<(uint)_name.size(); i++) {
+        auto rect = _name_char_rect(i);
+        if (((int)i != _hidden_char) && event->rect().intersects(rect)) {
+            _draw_char(painter, rect, _name.at(i), _name_char_style(i));
         }
-        else {
-            // The index is out of range, so don't show this picker item
-            _ascii_picker[i]->hide();
+    }
+
+    // Draw the ASCII picker if shown - the characters either side of the
+    // current character are shown, with the current character highlighted
+    if ((_picker_char != -1) && event->rect().intersects(_picker_rect())) {
+        auto rect = _picker_rect();
+        int index = _picker_char - ASCII_PICKER_SEL_ROW;
+        for (uint i=0; i<ASCII_PICKER_SIZE; i++, index++) {
+            if ((index >= 0) && (index < (int)NUM_ASCII_CHARS)) {
+                QRect char_rect(rect.x(), (rect.y() + (i * EDIT_NAME_CHAR_HEIGHT)), EDIT_NAME_SEL_CHAR_WIDTH, EDIT_NAME_CHAR_HEIGHT);
+                _draw_char(painter, char_rect, _ascii_chars[index], ((i == ASCII_PICKER_SEL_ROW) ? GlyphStyle::INVERTED : GlyphStyle::NORMAL));
+            }
         }
-        index++;
     }
 }
 
 //----------------------------------------------------------------------------
-// refresh_colour
+// _render_glyph_strips
 //----------------------------------------------------------------------------
-void EditName::refresh_colour()
+void EditName::_render_glyph_strips()
 {
-    // Refresh the edit name object colours
-    for (uint i=0; i<EDIT_NAME_STR_LEN; i++) {
-        // If this is the first character
-        if (i == 0) {
-            // Highlight the character and move to the next char
-            _edit_name[i]->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }");
-        }          
-        else {
-            // Don't Highlight the character and move to the next char
-            _edit_name[i]->setStyleSheet("QLabel { color: " + utils::get_css_system_colour_str() + "; }");
+    QColor system_colour = utils::get_system_colour();
+    QColor text_colours[NUM_GLYPH_STYLES] = {system_colour, Qt::black, utils::get_dimmed_system_colour_brush().color()};
+    QColor bg_colours[NUM_GLYPH_STYLES] = {Qt::black, system_colour, Qt::black};
+
+    // Render each ASCII character, centred in a selected character cell, into
+    // a strip for each glyph style
+    for (uint s=0; s<NUM_GLYPH_STYLES; s++) {
+        _glyph_strips[s] = QPixmap((NUM_ASCII_CHARS * EDIT_NAME_SEL_CHAR_WIDTH), EDIT_NAME_CHAR_HEIGHT);
+        _glyph_strips[s].fill(bg_colours[s]);
+        QPainter painter(&_glyph_strips[s]);
+        painter.setFont(font());
+        painter.setPen(text_colours[s]);
+        for (uint i=0; i<NUM_ASCII_CHARS; i++) {
+            painter.drawText(QRect((i * EDIT_NAME_SEL_CHAR_WIDTH), 0, EDIT_NAME_SEL_CHAR_WIDTH, EDIT_NAME_CHAR_HEIGHT),
+                             Qt::AlignCenter, QString(QChar(_ascii_chars[i])));
         }
     }
+}
 
-    // Refresh the ASCII picker object colours
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++) {
-        // If this is the middle character
-        if (i == 3) {
-            // Highlight the character and move to the next char
-            _ascii_picker[i]->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }");
-        }          
-        else {
-            // Don't Highlight the character and move to the next char
-            _ascii_picker[i]->setStyleSheet("QLabel { color: " + utils::get_css_system_colour_str() + "; }");
-        }
-    }    
+//----------------------------------------------------------------------------
+// _name_char_style
+//----------------------------------------------------------------------------
+EditName::GlyphStyle EditName::_name_char_style(uint index) const
+{
+    // Highlight the selected character, and dim the following characters
+    // once a character has been explicitly selected
+    if ((int)index == _selected_char) {
+        return GlyphStyle::INVERTED;
+    }
+    return (_dim_after_selected && ((int)index > _selected_char)) ? GlyphStyle::DIMMED : GlyphStyle::NORMAL;
 }
 
 //----------------------------------------------------------------------------
-// _set_ascii_picker_geometry
+// _name_char_rect
 //----------------------------------------------------------------------------
-void EditName::_set_ascii_picker_geometry()
+QRect EditName::_name_char_rect(uint index) const
 {
-    auto x_offset = _edit_name[0]->x();
+    // The selected character is wider than the other characters
+    int x = _left_margin + (index * EDIT_NAME_CHAR_WIDTH);
+    if ((int)index > _selected_char) {
+        x += (EDIT_NAME_SEL_CHAR_WIDTH - EDIT_NAME_CHAR_WIDTH);
+    }
+    int width = ((int)index == _selected_char) ? EDIT_NAME_SEL_CHAR_WIDTH : EDIT_NAME_CHAR_WIDTH;
+    return QRect(x, (_top_margin + (EDIT_NAME_ROW * EDIT_NAME_CHAR_HEIGHT)), width, EDIT_NAME_CHAR_HEIGHT);
+}
 
-    // Set the geometry for each ASCII picker character
-    for (uint i=0; i<ASCII_PICKER_SIZE; i++) {
-        _ascii_picker[i]->setGeometry((x_offset + (_selected_char*EDIT_NAME_CHAR_WIDTH)),
-                                       _ascii_picker[i]->y(),
-                                       EDIT_NAME_SEL_CHAR_WIDTH,
-                                       EDIT_NAME_CHAR_HEIGHT);
-        _ascii_picker[i]->hide();
+//----------------------------------------------------------------------------
+// _name_rect
+//----------------------------------------------------------------------------
+QRect EditName::_name_rect() const
+{
+    return QRect(_left_margin, (_top_margin + (EDIT_NAME_ROW * EDIT_NAME_CHAR_HEIGHT)),
+                 (((EDIT_NAME_STR_LEN - 1) * EDIT_NAME_CHAR_WIDTH) + EDIT_NAME_SEL_CHAR_WIDTH), EDIT_NAME_CHAR_HEIGHT);
+}
+
+//----------------------------------------------------------------------------
+// _picker_rect
+//----------------------------------------------------------------------------
+QRect EditName::_picker_rect() const
+{
+    // The ASCII picker is shown over the selected character
+    int x = _left_margin + (((_selected_char > 0) ? _selected_char : 0) * EDIT_NAME_CHAR_WIDTH);
+    return QRect(x, _top_margin, EDIT_NAME_SEL_CHAR_WIDTH, (ASCII_PICKER_SIZE * EDIT_NAME_CHAR_HEIGHT));
+}
+
+//----------------------------------------------------------------------------
+// _draw_char
+//----------------------------------------------------------------------------
+void EditName::_draw_char(QPainter& painter, const QRect& rect, QChar c, GlyphStyle style)
+{
+    // Is this character in the glyph strips?
+    int index = (c.unicode() < 128) ? _glyph_index[c.unicode()] : -1;
+    if (index != -1) {
+        // Blit the character from the strip - narrower cells use the centre
+        // of the glyph cell
+        int src_x = (index * EDIT_NAME_SEL_CHAR_WIDTH) + ((EDIT_NAME_SEL_CHAR_WIDTH - rect.width()) / 2);
+        painter.drawPixmap(rect.topLeft(), _glyph_strips[style], QRect(src_x, 0, rect.width(), rect.height()));
+    }
+    else {
+        // Draw the character as text
+        painter.fillRect(rect, ((style == GlyphStyle::INVERTED) ? utils::get_system_colour() : QColor(Qt::black)));
+        painter.setFont(font());
+        painter.setPen((style == GlyphStyle::INVERTED) ? QColor(Qt::black) :
+                       ((style == GlyphStyle::DIMMED) ? utils::get_dimmed_system_colour_brush().color() : utils::get_system_colour()));
+        painter.drawText(rect, Qt::AlignCenter, QString(c));
     }
 }
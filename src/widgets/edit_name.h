@@ -10,6 +10,7 @@
 #define EDIT_NAME_H
 
 #include <QObject>
+#include <QPixmap>
 #include <QString>
 #include "gui_msg.h"
 #include "moniq_label.h"
@@ -20,6 +21,9 @@ constexpr uint NUM_ASCII_CHARS   = (1 + 26 + 10 + 1);
 constexpr uint ASCII_PICKER_SIZE = 7;
 
 // Edit Name class
+// The name and ASCII picker are painted by the widget itself, by blitting the
+// characters from pre-rendered glyph strips, so each edit step only repaints
+// the character cells it affects
 class EditName: public MoniqLabel
 {
     Q_OBJECT    
@@ -37,15 +41,39 @@ public:
     void change_edit_name_char(uint ascii_index);   
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
 private:
+    // Glyph styles
+    enum GlyphStyle : uint
+    {
+        NORMAL,
+        INVERTED,
+        DIMMED,
+        NUM_GLYPH_STYLES
+    };
+
     // Private data
-    QLabel *_edit_name[EDIT_NAME_STR_LEN];
-    QLabel *_ascii_picker[ASCII_PICKER_SIZE];
+    QString _name;
     char _ascii_chars[NUM_ASCII_CHARS];
+    int _glyph_index[128];
+    QPixmap _glyph_strips[NUM_GLYPH_STYLES];
     int _selected_char;
+    int _hidden_char;
+    bool _dim_after_selected;
+    int _picker_char;
+    int _left_margin;
+    int _top_margin;
 
     // Private functions
-    void _set_ascii_picker_geometry();
+    void _render_glyph_strips();
+    GlyphStyle _name_char_style(uint index) const;
+    QRect _name_char_rect(uint index) const;
+    QRect _name_rect() const;
+    QRect _picker_rect() const;
+    void _draw_char(QPainter& painter, const QRect& rect, QChar c, GlyphStyle style);
 };
 
 #endif
@@ -0,0 +1,105 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  list_row.cpp
+ * @brief List Row class implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include "list_row.h"
+#include "gui_common.h"
+#include "style_registry.h"
+
+// Constants
+constexpr int PADDING_LEFT           = 20;
+constexpr int PADDING_RIGHT          = 10;
+constexpr int SEPARATOR_PADDING_TOP  = 2;
+
+//----------------------------------------------------------------------------
+// Paint
+//----------------------------------------------------------------------------
+void ListRow::Paint(QPainter& painter, const QRect& rect, const QStaticText& text, ListRowStyle style, const ListRowState& state)
+{
+    // Get the precomputed palette for this row state
+    const auto& palette = style_registry::list_row_palette(state.selected, state.enabled, state.separator);
+    int padding_left = 0;
+    int padding_top = 0;
+
+    // Boxed rows draw their own background and bottom border
+    if (style == ListRowStyle::BOXED) {
+        if (palette.background.alpha()) {
+            painter.fillRect(rect, palette.background);
+        }
+        painter.setPen(palette.border);
+        int y = rect.bottom() - (palette.border.width() / 2);
+        painter.drawLine(rect.left(), y, rect.right(), y);
+        padding_left = PADDING_LEFT;
+        padding_top = state.separator ? SEPARATOR_PADDING_TOP : 0;
+    }
+
+    // Draw the pre-laid out text, vertically centred in the row
+    int text_height = text.size().height();
+    int y = rect.top() + padding_top + ((rect.height() - padding_top - text_height) / 2);
+    painter.setPen(palette.text);
+    painter.setClipRect(rect.adjusted(padding_left, 0, -PADDING_RIGHT, 0));
+    painter.drawStaticText((rect.left() + padding_left), y, text);
+    painter.setClipping(false);
+}
+
+//----------------------------------------------------------------------------
+// ListRow
+//----------------------------------------------------------------------------
+ListRow::ListRow(ListRowStyle style, const QFont& font, QWidget *parent) : QWidget(parent)
+{
+    // Initialise the class data
+    _style = style;
+    _state = {false, true, false};
+    _static_text.setTextFormat(Qt::PlainText);
+    setFont(font);
+}
+
+//----------------------------------------------------------------------------
+// set_text
+//----------------------------------------------------------------------------
+void ListRow::set_text(const QString& text)
+{
+    // Lay out the text once for the row font
+    _static_text.setText(text);
+    _static_text.prepare(QTransform(), font());
+    update();
+}
+
+//----------------------------------------------------------------------------
+// set_state
+//----------------------------------------------------------------------------
+void ListRow::set_state(bool selected, bool enabled, bool separator)
+{
+    // Only repaint the row if its state has changed
+    ListRowState state = {selected, enabled, separator};
+    if (!(state == _state)) {
+        _state = state;
+        update();
+    }
+}
+
+//----------------------------------------------------------------------------
+// set_selected
+//----------------------------------------------------------------------------
+void ListRow::set_selected(bool selected)
+{
+    // Change the selected state only
+    set_state(selected, _state.enabled, _state.separator);
+}
+
+//----------------------------------------------------------------------------
+// paintEvent
+//----------------------------------------------------------------------------
+void ListRow::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    // Paint the row
+    painter.setFont(font());
+    Paint(painter, rect(), _static_text, _style, _state);
+}
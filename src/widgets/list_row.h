@@ -0,0 +1,68 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  list_row.h
+ * @brief List Row class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef LIST_ROW_H
+#define LIST_ROW_H
+
+#include <QWidget>
+#include <QFont>
+#include <QPainter>
+#include <QStaticText>
+#include <QString>
+
+// List Row Style
+enum class ListRowStyle
+{
+    BOXED,      // Row draws its own background, padding and bottom border
+    PLAIN       // Row draws its text only (the list draws the item)
+};
+
+// List Row State
+struct ListRowState
+{
+    bool selected;
+    bool enabled;
+    bool separator;
+
+    bool operator==(const ListRowState& other) const
+    {
+        return (selected == other.selected) && (enabled == other.enabled) && (separator == other.separator);
+    }
+};
+
+// List Row class
+// The row text is laid out once into a QStaticText when it is set, and the
+// row state only changes the colours used to paint it, so selecting or
+// scrolling a row does not re-run text layout
+class ListRow : public QWidget
+{
+    Q_OBJECT
+public:
+    // Helper functions
+    static void Paint(QPainter& painter, const QRect& rect, const QStaticText& text, ListRowStyle style, const ListRowState& state);
+
+    // Constructor
+    ListRow(ListRowStyle style, const QFont& font, QWidget *parent = nullptr);
+
+    // Public functions
+    void set_text(const QString& text);
+    void set_state(bool selected, bool enabled, bool separator);
+    void set_selected(bool selected);
+
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    // Private data
+    ListRowStyle _style;
+    QStaticText _static_text;
+    ListRowState _state;
+};
+
+#endif  // LIST_ROW_H
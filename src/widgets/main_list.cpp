@@ -6,59 +6,255 @@
  * @brief Main List class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <algorithm>
 #include "main_list.h"
 #include "gui_common.h"
+#include "style_registry.h"
+#include "text_elider.h"
 #include "utils.h"
 
 // Constants
 constexpr uint LIST_FONT_SIZE         = 30;
-constexpr uint LIST_ITEM_MARGIN_LEFT  = 20;
-constexpr uint LIST_ITEM_MARGIN_RIGHT = 20;
+constexpr uint MAX_CACHED_MODELS      = 8;
+constexpr uint MAX_ROW_PIXMAPS        = 32;
 
 //----------------------------------------------------------------------------
-// StatusBar
+// MainListModel
 //----------------------------------------------------------------------------
-MainList::MainList(uint num_rows, QWidget *parent) : QListWidget(parent)
+MainListModel::MainListModel(QObject *parent) : QAbstractListModel(parent)
 {
-    // Create the dummy label - not visible
-    // This is used to calculate max string lengths
-    _dummy_label = new MoniqLabel(this);
-	_dummy_label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE)); 
-    _dummy_label->setVisible(false);
+    // Initialise the class data
+    _selected_row = -1;
+}
+
+//----------------------------------------------------------------------------
+// rowCount
+//----------------------------------------------------------------------------
+int MainListModel::rowCount(const QModelIndex& parent) const
+{
+    // This is a flat list
+    return parent.isValid() ? 0 : _rows.size();
+}
+
+//----------------------------------------------------------------------------
+// data
+//----------------------------------------------------------------------------
+QVariant MainListModel::data(const QModelIndex& index, int role) const
+{
+    // Only the display text is provided - the delegate paints the rows
+    // directly from the model rows
+    if (index.isValid() && (role == Qt::DisplayRole)) {
+        return _rows[index.row()].item.text;
+    }
+    return QVariant();
+}
+
+//----------------------------------------------------------------------------
+// set_rows
+//----------------------------------------------------------------------------
+void MainListModel::set_rows(const std::vector<MainListItem>& items)
+{
+    int num_rows = _rows.size();
+    int num_items = items.size();
+    int num_common = std::min(num_rows, num_items);
+
+    // Update only the rows that have changed - unchanged rows keep their
+    // laid out text, so re-sending an identical list costs nothing
+    for (int i=0; i<num_common; i++) {
+        if (!(_rows[i].item == items[i])) {
+            _rows[i] = {items[i], QStaticText(), -1};
+            emit dataChanged(index(i), index(i));
+        }
+    }
+
+    // Remove any rows no longer in the list
+    if (num_rows > num_items) {
+        beginRemoveRows(QModelIndex(), num_items, num_rows - 1);
+        _rows.resize(num_items);
+        endRemoveRows();
+    }
+    // Append any new rows
+    else if (num_items > num_rows) {
+        beginInsertRows(QModelIndex(), num_rows, num_items - 1);
+        for (int i=num_rows; i<num_items; i++) {
+            _rows.push_back({items[i], QStaticText(), -1});
+        }
+        endInsertRows();
+    }
+}
+
+//----------------------------------------------------------------------------
+// row
+//----------------------------------------------------------------------------
+const MainListRow& MainListModel::row(int index) const
+{
+    return _rows[index];
+}
+
+//----------------------------------------------------------------------------
+// selected_row
+//----------------------------------------------------------------------------
+int MainListModel::selected_row() const
+{
+    return _selected_row;
+}
+
+//----------------------------------------------------------------------------
+// set_selected_row
+//----------------------------------------------------------------------------
+void MainListModel::set_selected_row(int index)
+{
+    // Only the previously and newly selected rows need repainting
+    int prev_row = _selected_row;
+    _selected_row = index;
+    if ((prev_row >= 0) && (prev_row < (int)_rows.size()) && (prev_row != index)) {
+        emit dataChanged(this->index(prev_row), this->index(prev_row));
+    }
+    if ((index >= 0) && (index < (int)_rows.size())) {
+        emit dataChanged(this->index(index), this->index(index));
+    }
+}
+
+//----------------------------------------------------------------------------
+// MainListDelegate
+//----------------------------------------------------------------------------
+MainListDelegate::MainListDelegate(const QFont& font, text_elider::ElideStyle elide_style, uint text_margin, QObject *parent) : 
+    QAbstractItemDelegate(parent), _font(font), _row_pixmaps(MAX_ROW_PIXMAPS)
+{
+    // Initialise the class data
+    _elide_style = elide_style;
+    _text_margin = text_margin;
+    _row_height = 0;
+}
+
+//----------------------------------------------------------------------------
+// paint
+//----------------------------------------------------------------------------
+void MainListDelegate::paint(QPainter *painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    auto model = static_cast<const MainListModel *>(index.model());
+    const auto& row = model->row(index.row());
+    ListRowState state = {(index.row() == model->selected_row()), row.item.enabled, row.item.separator};
+
+    // Has this row not been rendered in this state and size yet?
+    MainListRowPixmapKey key = {row.item.text, state, option.rect.size()};
+    auto pixmap = _row_pixmaps.object(key);
+    if (!pixmap) {
+        // Elide and lay out the row text if this is the first time it has been
+        // rendered at this width
+        int max_width = option.rect.width() - _text_margin;
+        if (row.static_text_width != max_width) {
+            row.static_text.setTextFormat(Qt::PlainText);
+            row.static_text.setText(text_elider::elide(row.item.text, _font, max_width, _elide_style).text);
+            row.static_text.prepare(QTransform(), _font);
+            row.static_text_width = max_width;
+        }
+
+        // Render the row into its pixmap, on the list background
+        pixmap = new QPixmap(option.rect.size());
+        pixmap->fill(style_registry::list_background());
+        QPainter pixmap_painter(pixmap);
+        pixmap_painter.setFont(_font);
+        ListRow::Paint(pixmap_painter, pixmap->rect(), row.static_text, ListRowStyle::BOXED, state);
+        pixmap_painter.end();
+        _row_pixmaps.insert(key, pixmap);
+    }
+
+    // Blit the row
+    painter->drawPixmap(option.rect.topLeft(), *pixmap);
+}
+
+//----------------------------------------------------------------------------
+// sizeHint
+//----------------------------------------------------------------------------
+QSize MainListDelegate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+
+    // All rows are the same height
+    return QSize(option.rect.width(), _row_height);
+}
 
+//----------------------------------------------------------------------------
+// set_row_height
+//----------------------------------------------------------------------------
+void MainListDelegate::set_row_height(int height)
+{
+    _row_height = height;
+}
+
+//----------------------------------------------------------------------------
+// clear_pixmap_cache
+//----------------------------------------------------------------------------
+void MainListDelegate::clear_pixmap_cache()
+{
+    // Clear the rendered rows, for example if the system colour has changed
+    _row_pixmaps.clear();
+}
+
+//----------------------------------------------------------------------------
+// MainList
+//----------------------------------------------------------------------------
+MainList::MainList(uint num_rows, QWidget *parent, text_elider::ElideStyle elide_style, uint text_margin) : 
+    QListView(parent), _cached_models(MAX_CACHED_MODELS)
+{
     // Setup the list object
+    // Note: Uniform item sizes means the view never has to measure every row,
+    // so the cost of the list scales with the visible rows, not the list length
+    _num_rows = num_rows;
+    _model = new MainListModel(this);
+    _model_key = 0;
+    _delegate = new MainListDelegate(style_registry::font(STANDARD_FONT_NAME, LIST_FONT_SIZE), elide_style, text_margin, this);
+    setModel(_model);
+    setItemDelegate(_delegate);
+    setUniformItemSizes(true);
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setFocusPolicy(Qt::NoFocus);
     setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
 
     // Set the initial list colour
 	refresh_colour();
     hide();
-    _num_rows = num_rows;
 }
 
 //----------------------------------------------------------------------------
-// add_item
+// set_items
 //----------------------------------------------------------------------------
-void MainList::add_item(const QString& text, bool selected, bool enabled, bool separator)
+void MainList::set_items(const std::vector<MainListItem>& items, int selected_item, std::size_t key)
 {
-    // Firstly set the text we can display, truncated if necessary
-    // We do this with the dummy QLabel object  
-    _dummy_label->set_text(text, (width() - LIST_ITEM_MARGIN_LEFT - LIST_ITEM_MARGIN_RIGHT));
+    // Is this a different list to the one currently shown?
+    if (key != _model_key) {
+        // Use the cached model for this list if there is one, otherwise
+        // create a new model
+        auto model = _cached_models.take(key);
+        _set_model((model ? model : new MainListModel(this)), key);
+    }
+
+    // Update the list rows that have changed, and then the selection
+    _model->set_rows(items);
+    _set_selected_item(selected_item);
+}
 
-    // Add this text item to the list, and resize it
-    auto label = new QLabel(this);
-    auto item = new QListWidgetItem(this);
-    label->setFont(QFont(STANDARD_FONT_NAME, LIST_FONT_SIZE));
-    _list_label_set_text(label, _dummy_label->text(), selected, enabled, separator);
-    item->setSizeHint(QSize(width(), (height() / _num_rows)));
-    addItem(item);
-    setItemWidget(item, label);
+//----------------------------------------------------------------------------
+// show_cached_items
+//----------------------------------------------------------------------------
+bool MainList::show_cached_items(std::size_t key, int selected_item)
+{
+    // Is this list not already shown?
+    if (key != _model_key) {
+        // Get the cached model for this list, if any
+        auto model = _cached_models.take(key);
+        if (!model) {
+            // Not cached - the caller must set the list items
+            return false;
+        }
+        _set_model(model, key);
+    }
 
-    // Save this list item
-    _list_items.push_back(_dummy_label->text().toStdString());
-    _list_items_enabled.push_back(enabled);
-    _list_items_separator.push_back(separator);
+    // Update the selection
+    _set_selected_item(selected_item);
+    return true;
 }
 
 //----------------------------------------------------------------------------
@@ -66,12 +262,10 @@ void MainList::add_item(const QString& text, bool selected, bool enabled, bool s
 //----------------------------------------------------------------------------
 void MainList::select_item(uint index)
 {
-    bool selected_item_enabled;
-
     // Check the selected item is within range
-    if (index < (uint)count()) {
+    if (index < (uint)_model->rowCount()) {
         // Its within range, so select that row
-        setCurrentRow(index);
+        _model->set_selected_row(index);
         
         // Trick to make QT scroll LOGICALLY and CONSISTENTLY (duh!)
         // Note this assumes that there are 6 items shown in the list
@@ -80,58 +274,25 @@ void MainList::select_item(uint index)
             i = 0;
         if (i == 4)
             i = 3;
-        scrollToItem(item(i), QAbstractItemView::PositionAtCenter);
-
-        // Update each list item
-        for (uint i=0; i<(uint)count(); i++) {
-            auto obj = reinterpret_cast<QLabel *>(itemWidget(item(i)));
-            _list_label_set_text(obj, _list_items[i].c_str(), (i == index), _list_items_enabled[i], _list_items_separator[i]);
-        }
+        scrollTo(_model->index(i), QAbstractItemView::PositionAtCenter);
     }
 }
 
 //----------------------------------------------------------------------------
-// _list_label_set_text
+// num_items
 //----------------------------------------------------------------------------
-void MainList::_list_label_set_text(QLabel *label, const QString& text, bool selected, bool enabled, bool separator)
+uint MainList::num_items() const
 {
-    QString fontColour = utils::get_css_system_colour_str() + ";";
-    QString bgColour = "transparent;";
-    QString paddingTop = "0px;";
-    QString borderStyle = "solid;";
-    QString borderWidth = "0.5px;";
-    QString borderColour = utils::get_css_system_colour_str() + ";";
+    return _model->rowCount();
+}
 
-    // Set the param list label text depending on the state of this list item
-    if (selected) {
-        if (!enabled) {
-            // Show the text dimmed
-            fontColour = utils::get_dimmed_css_system_colour_str();
-        }
-        else {
-            fontColour = "black;";
-        }
-        bgColour = utils::get_css_system_colour_str() + ";";
-        if (separator) {
-            borderColour = "black;";
-        }            
-    }
-    else {
-        if (!enabled) {
-            // Show the text dimmed
-            fontColour = utils::get_dimmed_css_system_colour_str();
-        }               
-    }
-    if (separator) {
-        paddingTop = "2.0px;";
-        borderStyle = "dotted;";
-        borderWidth = "3.0px;";
-    }        
-    label->setText(text);
-    label->setStyleSheet(
-        "QLabel { color:" + fontColour + "; background-color:" + bgColour + 
-        "padding-left: 20px; padding-right: 10px; padding-top:" + paddingTop +
-        "border-style:" + borderStyle + "border-bottom-width:" + borderWidth + "border-color:" + borderColour + "; }");
+//----------------------------------------------------------------------------
+// item_text
+//----------------------------------------------------------------------------
+QString MainList::item_text(uint index) const
+{
+    // Return the full (un-elided) item text
+    return (index < num_items()) ? _model->row(index).item.text : QString();
 }
 
 //----------------------------------------------------------------------------
@@ -139,8 +300,53 @@ void MainList::_list_label_set_text(QLabel *label, const QString& text, bool sel
 //----------------------------------------------------------------------------
 void MainList::refresh_colour()
 {
-    // Refresh the object colours
-	setStyleSheet(
-        "QListWidget { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"
-        "QListWidget::item::selected { color: black; background: " + utils::get_css_system_colour_str() + "; }");
+    // Refresh the object colours - the rows are rendered in the system colour
+    // so the rendered rows are discarded and repainted
+	setStyleSheet(style_registry::css(style_registry::Css::MAIN_LIST));
+    _delegate->clear_pixmap_cache();
+    viewport()->update();
+}
+
+//----------------------------------------------------------------------------
+// resizeEvent
+//----------------------------------------------------------------------------
+void MainList::resizeEvent(QResizeEvent *event)
+{
+    // Fit the specified number of rows in the list
+    _delegate->set_row_height(height() / _num_rows);
+    QListView::resizeEvent(event);
+    doItemsLayout();
+}
+
+//----------------------------------------------------------------------------
+// _set_model
+//----------------------------------------------------------------------------
+void MainList::_set_model(MainListModel *model, std::size_t key)
+{
+    // Move the current model into the cache - this may evict (and delete) the
+    // least recently used cached model
+    _cached_models.insert(_model_key, _model);
+
+    // Show the new model
+    // Note: The view does not delete its selection model when the model is
+    // changed, so this is done here
+    auto selection_model = selectionModel();
+    setModel(model);
+    delete selection_model;
+    _model = model;
+    _model_key = key;
+}
+
+//----------------------------------------------------------------------------
+// _set_selected_item
+//----------------------------------------------------------------------------
+void MainList::_set_selected_item(int selected_item)
+{
+    // Select the item, or clear the selection if none is specified
+    if (selected_item != -1) {
+        select_item(selected_item);
+    }
+    else {
+        _model->set_selected_row(-1);
+    }
 }
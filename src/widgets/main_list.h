@@ -9,33 +9,153 @@
 #ifndef MAIN_LIST_H
 #define MAIN_LIST_H
 
-#include <QListWidget>
+#include <vector>
+#include <QAbstractItemDelegate>
+#include <QAbstractListModel>
+#include <QCache>
+#include <QFont>
+#include <QHash>
+#include <QListView>
+#include <QPixmap>
+#include <QStaticText>
 #include <QString>
-#include "moniq_label.h"
+#include "list_row.h"
+#include "text_elider.h"
+
+// Constants
+// Note: The row text is elided to the row width less the text margin
+constexpr uint MAIN_LIST_TEXT_MARGIN = 40;
+
+// Main List item
+struct MainListItem
+{
+    QString text;
+    bool enabled;
+    bool separator;
+
+    bool operator==(const MainListItem& other) const
+    {
+        return (text == other.text) && (enabled == other.enabled) && (separator == other.separator);
+    }
+};
+
+// Main List row
+// Note: The row text is only elided and laid out when the row is first
+// painted, so rows that are never scrolled into view cost just a copy
+struct MainListRow
+{
+    MainListItem item;
+    mutable QStaticText static_text;
+    mutable int static_text_width;
+};
+
+// Main List Model class
+class MainListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // Constructor
+    explicit MainListModel(QObject *parent = nullptr);
+
+    // Public functions
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    void set_rows(const std::vector<MainListItem>& items);
+    const MainListRow& row(int index) const;
+    int selected_row() const;
+    void set_selected_row(int index);
+
+private:
+    // Private data
+    std::vector<MainListRow> _rows;
+    int _selected_row;
+};
+
+// Main List row pixmap key
+// Note: The row pixmaps are keyed by their content and state, so they remain
+// valid when a row is moved, or the list model is changed
+struct MainListRowPixmapKey
+{
+    QString text;
+    ListRowState state;
+    QSize size;
+
+    bool operator==(const MainListRowPixmapKey& other) const
+    {
+        return (text == other.text) && (state == other.state) && (size == other.size);
+    }
+};
+
+inline uint qHash(const MainListRowPixmapKey& key, uint seed=0)
+{
+    return qHash(key.text, seed) ^ qHash((key.state.selected ? 0x01 : 0) | (key.state.enabled ? 0x02 : 0) | (key.state.separator ? 0x04 : 0), seed) ^
+           qHash(key.size.width(), seed) ^ qHash(key.size.height(), seed);
+}
+
+// Main List Delegate class
+// Paints each row directly with ListRow::Paint - there are no per-row widgets.
+// Each row is rendered once into a pixmap, so scrolling and selection changes
+// just blit the cached rows, whatever the complexity of their text
+class MainListDelegate : public QAbstractItemDelegate
+{
+    Q_OBJECT
+public:
+    // Constructor
+    MainListDelegate(const QFont& font, text_elider::ElideStyle elide_style, uint text_margin, QObject *parent = nullptr);
+
+    // Public functions
+    void paint(QPainter *painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
+    void set_row_height(int height);
+    void clear_pixmap_cache();
+
+private:
+    // Private data
+    QFont _font;
+    text_elider::ElideStyle _elide_style;
+    uint _text_margin;
+    int _row_height;
+    mutable QCache<MainListRowPixmapKey, QPixmap> _row_pixmaps;
+};
 
 // Main List class
-class MainList: public QListWidget
+// Note: Only the visible rows are ever laid out and painted, so the main
+// and enum lists can hold very large item lists at a constant per-frame cost.
+// The models of recently shown lists are kept in a small cache, keyed by the
+// caller, so returning to a list re-uses its already laid out rows
+// Note: This only saves rebuilding the rows - the caller still receives the
+// full list contents each time a list is shown
+class MainList: public QListView
 {
     Q_OBJECT
 public:
     // Constructors
-    explicit MainList(uint num_rows, QWidget *parent = nullptr);
+    explicit MainList(uint num_rows, QWidget *parent = nullptr, text_elider::ElideStyle elide_style = text_elider::ElideStyle::RIGHT,
+                      uint text_margin = MAIN_LIST_TEXT_MARGIN);
 
     // Public functions
-    void add_item(const QString& text, bool selected, bool enabled, bool separator);
+    void set_items(const std::vector<MainListItem>& items, int selected_item, std::size_t key);
+    bool show_cached_items(std::size_t key, int selected_item);
     void select_item(uint index);
+    uint num_items() const;
+    QString item_text(uint index) const;
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void resizeEvent(QResizeEvent *event) override;
+
 private:
     // Private data
     uint _num_rows;
-    std::vector<std::string> _list_items;
-    std::vector<bool> _list_items_enabled;
-    std::vector<bool> _list_items_separator;
-    MoniqLabel *_dummy_label;
+    MainListModel *_model;
+    std::size_t _model_key;
+    QCache<std::size_t, MainListModel> _cached_models;
+    MainListDelegate *_delegate;
 
     // Private functions
-    void _list_label_set_text(QLabel *label, const QString& text, bool selected, bool enabled, bool separator);
+    void _set_model(MainListModel *model, std::size_t key);
+    void _set_selected_item(int selected_item);
 };
 
 #endif
@@ -8,6 +8,7 @@
  */
 #include "moniq_label.h"
 #include "gui_common.h"
+#include "text_elider.h"
 #include "utils.h"
 
 //----------------------------------------------------------------------------
@@ -24,21 +25,17 @@ MoniqLabel::MoniqLabel(QWidget *parent)
 //----------------------------------------------------------------------------
 void MoniqLabel::set_text(const QString& text, int max_width)
 {
-    QString str = text;
+    // Elide the text to fit within the max width, allowing for any label
+    // margins (including style sheet padding)
+    if (max_width != -1) {
+        auto margins = contentsMargins();
+        max_width -= margins.left() + margins.right() + (margin() * 2);
+    }
+    auto elided = text_elider::elide(text, font(), max_width);
 
     // Update the object text
-    setText(str);
+    setText(elided.text);
     adjustSize();
-    if (max_width != -1) {
-        uint w = width();
-        while (w > (uint)max_width) {
-            str = str.mid(0, str.size() - 1);
-            QString trunc_str = str + "~";
-            setText(trunc_str);
-            adjustSize();
-            w = width();
-        }
-    }
 }
 
 //----------------------------------------------------------------------------
@@ -9,6 +9,7 @@
 #include <QMovie>
 #include "msg_box.h"
 #include "gui_common.h"
+#include "style_registry.h"
 #include "utils.h"
 
 // Constants
@@ -30,13 +31,13 @@ MsgBox::MsgBox(QWidget *parent) : MoniqLabel(parent)
     // Create the border and line objects
     _border = new MoniqLabel(this);
     _line_1 = new MoniqLabel(this);
-	_line_1->setFont(QFont(STANDARD_FONT_NAME, LINE_1_FONT_SIZE));
+	_line_1->setFont(style_registry::font(STANDARD_FONT_NAME, LINE_1_FONT_SIZE));
     _line_1->setAlignment(Qt::AlignCenter);
     _line_2 = new MoniqLabel(this);
-	_line_2->setFont(QFont(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
+	_line_2->setFont(style_registry::font(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
     _line_2->setAlignment(Qt::AlignCenter);
     _line_3 = new MoniqLabel(this);
-	_line_3->setFont(QFont(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
+	_line_3->setFont(style_registry::font(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
     _line_3->setAlignment(Qt::AlignCenter);
 
     // Create the hourglass object
@@ -158,10 +159,10 @@ void MsgBox::show_msg(const QString& line_1, const QString& line_2, const QStrin
 void MsgBox::refresh_colour()
 {
     // Refresh the message dialog object colours
-    _border->setStyleSheet("QLabel { background-color: black; border: 10px solid " + utils::get_css_system_colour_str() + "; }");
-	_line_1->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"); 
-	_line_2->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"); 
-	_line_3->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str() + "; }"); 
+    _border->setStyleSheet(style_registry::css(style_registry::Css::MSG_BOX_BORDER));
+	_line_1->setStyleSheet(style_registry::css(style_registry::Css::LABEL_BLACK_BG)); 
+	_line_2->setStyleSheet(style_registry::css(style_registry::Css::LABEL_BLACK_BG)); 
+	_line_3->setStyleSheet(style_registry::css(style_registry::Css::LABEL_BLACK_BG)); 
 
     // Create the warning hourglass - firstly we need to read each pixmap
     // from the hourglass GIF
@@ -8,6 +8,7 @@
  */
 #include "msg_popup.h"
 #include "gui_common.h"
+#include "style_registry.h"
 #include "utils.h"
 
 // Constants
@@ -24,11 +25,11 @@ MsgPopup::MsgPopup(QWidget *parent) : MoniqLabel(parent)
 {
     // Create the line objects
     _line_1 = new MoniqLabel(this);
-	_line_1->setFont(QFont(STANDARD_FONT_NAME, LINE_1_FONT_SIZE));
+	_line_1->setFont(style_registry::font(STANDARD_FONT_NAME, LINE_1_FONT_SIZE));
     _line_1->setAlignment(Qt::AlignCenter);
 	_line_1->setStyleSheet("QLabel { background-color: transparent; color : black; border: none; }");  
     _line_2 = new MoniqLabel(this);
-	_line_2->setFont(QFont(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
+	_line_2->setFont(style_registry::font(STANDARD_FONT_NAME, LINE_2_FONT_SIZE));
     _line_2->setAlignment(Qt::AlignCenter);
 	_line_2->setStyleSheet("QLabel { background-color: transparent; color : black; border: none; }"); 
 
@@ -88,7 +89,7 @@ void MsgPopup::show_msg(const QString& line_1, const QString& line_2)
 void MsgPopup::refresh_colour()
 {
     // Refresh the message dialog object colours
-    setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; border: 40px solid black; }");  	 
+    setStyleSheet(style_registry::css(style_registry::Css::MSG_POPUP));  	 
 }
 
 //----------------------------------------------------------------------------
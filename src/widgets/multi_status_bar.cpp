@@ -6,8 +6,12 @@
  * @brief Multi Status Bar class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <QPainter>
+#include <QPaintEvent>
 #include "multi_status_bar.h"
 #include "gui_common.h"
+#include "style_registry.h"
+#include "text_elider.h"
 #include "utils.h"
 
 // Constants
@@ -23,21 +27,15 @@ MultiStatusBar::MultiStatusBar(QWidget *parent) : MoniqLabel(parent)
     // Initialise class data
     _current_layer = Layer::LAYER_1;
 
-    // Create the L1 sound name
-    _l1_sound_name = new MoniqLabel(parent);
-	_l1_sound_name->setFont(QFont(STANDARD_FONT_NAME, SOUND_NAME_FONT_SIZE));
-    _l1_sound_name->setAlignment(Qt::AlignCenter);
-    _l1_sound_name->setText("----");
-    _l1_sound_name->adjustSize();
-    _l1_sound_name->show();
-
-    // Create the L2 sound name
-    _l2_sound_name = new MoniqLabel(parent);
-	_l2_sound_name->setFont(QFont(STANDARD_FONT_NAME, SOUND_NAME_FONT_SIZE));
-    _l2_sound_name->setAlignment(Qt::AlignCenter);
-    _l2_sound_name->setText("----");
-    _l2_sound_name->adjustSize();
-    _l2_sound_name->show();
+    // The bar paints every pixel itself
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setFont(style_registry::font(STANDARD_FONT_NAME, SOUND_NAME_FONT_SIZE));
+
+    // Lay out the initial L1 and L2 sound names
+    _l1_sound_name.setTextFormat(Qt::PlainText);
+    _set_sound_name(_l1_sound_name, "----", -1);
+    _l2_sound_name.setTextFormat(Qt::PlainText);
+    _set_sound_name(_l2_sound_name, "----", -1);
 
     // Refresh the colours and hide the bar
 	refresh_colour();
@@ -45,89 +43,110 @@ MultiStatusBar::MultiStatusBar(QWidget *parent) : MoniqLabel(parent)
 }
 
 //----------------------------------------------------------------------------
-// setGeometry
+// set_l1_sound_name
 //----------------------------------------------------------------------------
-void MultiStatusBar::setGeometry(int x, int y, int w, int h)
+void MultiStatusBar::set_l1_sound_name(const QString &name)
 {
-    // Set the multi status bar geometry
-    MoniqLabel::setGeometry(x, y, w, h);
+    auto max_width = ((width() / 2) - (PADDING * 2));
 
-    // Set the L1 sound name geometry
-    _l1_sound_name->setGeometry (x, y, (w / 2), h);
+    // Update the L1 sound name
+    _set_sound_name(_l1_sound_name, name, max_width);
+    update(_sound_name_rect(Layer::LAYER_1));
+}
+
+//----------------------------------------------------------------------------
+// set_l2_sound_name
+//----------------------------------------------------------------------------
+void MultiStatusBar::set_l2_sound_name(const QString &name)
+{
+    auto max_width = ((width() / 2) - (PADDING * 2));
 
-    // Set the L2 sound name geometry
-    _l2_sound_name->setGeometry ((x + (w / 2)), y, (w / 2), h);
+    // Update the L2 sound name
+    _set_sound_name(_l2_sound_name, name, max_width);
+    update(_sound_name_rect(Layer::LAYER_2));
 }
 
 //----------------------------------------------------------------------------
-// show
+// select_layer
 //----------------------------------------------------------------------------
-void MultiStatusBar::show()
+void MultiStatusBar::select_layer(Layer layer)
 {
-    // Show the object
-    _l1_sound_name->show();
-    _l2_sound_name->show();
-    MoniqLabel::show();
+    // Save the current layer and repaint both sound names if it has changed
+    if (layer != _current_layer) {
+        _current_layer = layer;
+        update(_sound_name_rect(Layer::LAYER_1) | _sound_name_rect(Layer::LAYER_2));
+    }
 }
 
 //----------------------------------------------------------------------------
-// hide
+// refresh_colour
 //----------------------------------------------------------------------------
-void MultiStatusBar::hide()
+void MultiStatusBar::refresh_colour()
 {
-    // Hide the object
-    _l1_sound_name->hide();
-    _l2_sound_name->hide();
-    MoniqLabel::hide();
+    // The colours are read when painting, so just repaint the bar
+    update();
 }
 
 //----------------------------------------------------------------------------
-// set_l1_sound_name
+// paintEvent
 //----------------------------------------------------------------------------
-void MultiStatusBar::set_l1_sound_name(const QString &name)
+void MultiStatusBar::paintEvent(QPaintEvent *event)
 {
-    auto max_width = ((width() / 2) - (PADDING * 2));
+    QPainter painter(this);
 
-    // Update the L1 sound name
-    _l1_sound_name->set_text(name, max_width);
-    _l1_sound_name->setGeometry (x(), y(), (width() / 2), (height() - BOTTOM_BORDER_SIZE));
+    // Clear the area being repainted - the system colour background forms
+    // the bottom border
+    painter.fillRect(event->rect(), utils::get_system_colour());
+
+    // Draw the sound names that need repainting
+    painter.setFont(font());
+    if (event->rect().intersects(_sound_name_rect(Layer::LAYER_1))) {
+        _draw_sound_name(painter, _l1_sound_name, Layer::LAYER_1);
+    }
+    if (event->rect().intersects(_sound_name_rect(Layer::LAYER_2))) {
+        _draw_sound_name(painter, _l2_sound_name, Layer::LAYER_2);
+    }
 }
 
 //----------------------------------------------------------------------------
-// set_l2_sound_name
+// _set_sound_name
 //----------------------------------------------------------------------------
-void MultiStatusBar::set_l2_sound_name(const QString &name)
+void MultiStatusBar::_set_sound_name(QStaticText& sound_name, const QString &name, int max_width)
 {
-    auto max_width = ((width() / 2) - (PADDING * 2));
-
-    // Update the L2 sound name
-    _l2_sound_name->set_text(name, max_width);
-    _l2_sound_name->setGeometry ((x() + (width() / 2)), y(), (width() / 2), (height() - BOTTOM_BORDER_SIZE));
+    // Elide and lay out the sound name
+    sound_name.setText(text_elider::elide(name, font(), max_width).text);
+    sound_name.prepare(QTransform(), font());
 }
 
 //----------------------------------------------------------------------------
-// select_layer
+// _sound_name_rect
 //----------------------------------------------------------------------------
-void MultiStatusBar::select_layer(Layer layer)
+QRect MultiStatusBar::_sound_name_rect(Layer layer) const
 {
-    // Save the current layer and refresh the object
-    _current_layer = layer;
-    refresh_colour();
+    int x = (layer == Layer::LAYER_1) ? 0 : (width() / 2);
+    return QRect(x, 0, (width() / 2), (height() - BOTTOM_BORDER_SIZE));
 }
 
 //----------------------------------------------------------------------------
-// refresh_colour
+// _draw_sound_name
 //----------------------------------------------------------------------------
-void MultiStatusBar::refresh_colour()
+void MultiStatusBar::_draw_sound_name(QPainter& painter, const QStaticText& sound_name, Layer layer)
 {
-    // Refresh the layer sound bar object colours
-    if (_current_layer == Layer::LAYER_1) {
-        _l1_sound_name->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; }");
-        _l2_sound_name->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str()  + "; }");
+    auto rect = _sound_name_rect(layer);
+    auto size = sound_name.size();
+
+    // The current layer is shown as black text on the system colour, and the
+    // other layer as system colour text on black
+    if (layer == _current_layer) {
+        painter.fillRect(rect, utils::get_system_colour());
+        painter.setPen(Qt::black);
     }
     else {
-        _l1_sound_name->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str()  + "; }");
-        _l2_sound_name->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; }");   
+        painter.fillRect(rect, Qt::black);
+        painter.setPen(utils::get_system_colour());
     }
-	setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; }"); 
+
+    // Draw the sound name centred in its half of the bar
+    painter.drawStaticText((rect.x() + ((rect.width() - size.width()) / 2)),
+                           (rect.y() + ((rect.height() - size.height()) / 2)), sound_name);
 }
@@ -9,11 +9,15 @@
 #ifndef MULTI_STATUS_BAR_H
 #define MULTI_STATUS_BAR_H
 
+#include <QPainter>
+#include <QStaticText>
 #include <QString>
 #include "moniq_label.h"
 #include "gui_msg.h"
 
 // Multi Status Bar class
+// The bar is painted by the widget itself from pre-laid out sound names, so
+// changing a sound name only repaints its half of the bar
 class MultiStatusBar: public MoniqLabel
 {
     Q_OBJECT
@@ -21,22 +25,26 @@ public:
     // Constructors
     explicit MultiStatusBar(QWidget *parent = nullptr);
 
-    // Overriden functions
-    void setGeometry(int x, int y, int w, int h);
-    void show();
-    void hide();
-
     // Public functions
     void set_l1_sound_name(const QString &name);
     void set_l2_sound_name(const QString &name);
     void select_layer(Layer layer);
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     // Private data
-    MoniqLabel *_l1_sound_name;
-    MoniqLabel *_l2_sound_name;
+    QStaticText _l1_sound_name;
+    QStaticText _l2_sound_name;
     Layer _current_layer;
+
+    // Private functions
+    void _set_sound_name(QStaticText& sound_name, const QString &name, int max_width);
+    QRect _sound_name_rect(Layer layer) const;
+    void _draw_sound_name(QPainter& painter, const QStaticText& sound_name, Layer layer);
 };
 
 #endif  // MULTI_STATUS_BAR_H
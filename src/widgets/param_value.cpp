@@ -0,0 +1,188 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  param_value.cpp
+ * @brief Param Value class implementation.
+ *-----------------------------------------------------------------------------
+ */
+#include <QPainter>
+#include "param_value.h"
+#include "gui_common.h"
+#include "text_elider.h"
+#include "utils.h"
+
+// Constants
+constexpr uint PARAM_VALUE_NUM_FONT_SIZE     = 80;
+constexpr uint PARAM_VALUE_TXT_FONT_SIZES[] = { 36, 32, 28, 24 };
+
+//----------------------------------------------------------------------------
+// ParamValueMetrics
+//----------------------------------------------------------------------------
+ParamValueMetrics::ParamValueMetrics() : _atlas(PARAM_VALUE_NUM_FONT_SIZE)
+{
+    // Create the text fonts in the ladder (largest first), and their metrics
+    // Note: The fonts are created here rather than shared from the style
+    // registry, as the registry fonts must only be used from the GUI thread
+    for (auto size : PARAM_VALUE_TXT_FONT_SIZES) {
+        QFont font(STANDARD_FONT_NAME, size);
+        _text_fonts.push_back({font, QFontMetrics(font)});
+    }
+    _shrink_to_fit = utils::get_param_value_shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------
+// atlas
+//----------------------------------------------------------------------------
+const Dseg7GlyphAtlas& ParamValueMetrics::atlas() const
+{
+    return _atlas;
+}
+
+//----------------------------------------------------------------------------
+// num_font
+//----------------------------------------------------------------------------
+const QFont& ParamValueMetrics::num_font() const
+{
+    return _atlas.font();
+}
+
+//----------------------------------------------------------------------------
+// text_font
+//----------------------------------------------------------------------------
+const QFont& ParamValueMetrics::text_font(uint index) const
+{
+    return _text_fonts[index].font;
+}
+
+//----------------------------------------------------------------------------
+// value
+//----------------------------------------------------------------------------
+ParamValueLayout ParamValueMetrics::value(const QString& value, int max_width) const
+{
+    // If all the value glyphs are in the atlas, the value can be elided and
+    // measured from the glyph advances
+    if (_atlas.contains(value)) {
+        auto text = _atlas.elide(value, max_width);
+        return {text, true, true, 0, QSize(_atlas.text_width(text), _atlas.height())};
+    }
+
+    // Fallback to measuring the value as text with the DSEG7 font
+    auto elided = text_elider::elide(value, _atlas.font(), max_width);
+    return {elided.text, true, false, 0, QSize(elided.width, _atlas.height())};
+}
+
+//----------------------------------------------------------------------------
+// text
+//----------------------------------------------------------------------------
+ParamValueLayout ParamValueMetrics::text(const QString& text, int max_width) const
+{
+    // Measure the text with the largest font it fits, and elide it if it
+    // doesn't fit even the smallest font
+    uint index = _fit_text_font(text, max_width);
+    const auto& font = _text_fonts[index];
+    auto elided = text_elider::elide(text, font.font, max_width);
+    return {elided.text, false, false, index, QSize(elided.width, font.metrics.height())};
+}
+
+//----------------------------------------------------------------------------
+// _fit_text_font
+//----------------------------------------------------------------------------
+uint ParamValueMetrics::_fit_text_font(const QString& text, int max_width) const
+{
+    // If not shrinking to fit, always use the largest font
+    uint smallest = _text_fonts.size() - 1;
+    if (!_shrink_to_fit || (max_width == -1)) {
+        return 0;
+    }
+
+    // The text width decreases with the font size, so binary search the ladder
+    // for the first (largest) font the text fits - if it doesn't fit any of
+    // them, the smallest font is used
+    uint lo = 0;
+    uint hi = smallest;
+    while (lo < hi) {
+        uint mid = (lo + hi) / 2;
+        if (_text_fonts[mid].metrics.horizontalAdvance(text) <= max_width) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+//----------------------------------------------------------------------------
+// ParamValue
+//----------------------------------------------------------------------------
+ParamValue::ParamValue(QWidget *parent) : QWidget(parent)
+{
+    // Initialise the class data
+    _use_atlas = true;
+
+    // Render the glyphs in the system colour
+    refresh_colour();
+    hide();
+}
+
+//----------------------------------------------------------------------------
+// set_value
+//----------------------------------------------------------------------------
+void ParamValue::set_value(const QString& value, int max_width)
+{
+    // Show the value, drawn from the atlas if possible
+    set_layout(_metrics.value(value, max_width));
+}
+
+//----------------------------------------------------------------------------
+// set_text
+//----------------------------------------------------------------------------
+void ParamValue::set_text(const QString& text, int max_width)
+{
+    // Show the text with the standard font
+    set_layout(_metrics.text(text, max_width));
+}
+
+//----------------------------------------------------------------------------
+// set_layout
+//----------------------------------------------------------------------------
+void ParamValue::set_layout(const ParamValueLayout& layout)
+{
+    // Apply the (already measured) text and size
+    _text = layout.text;
+    _use_atlas = layout.use_atlas;
+    setFont(layout.numeric ? _metrics.num_font() : _metrics.text_font(layout.text_font_index));
+    resize(layout.size);
+    update();
+}
+
+//----------------------------------------------------------------------------
+// refresh_colour
+//----------------------------------------------------------------------------
+void ParamValue::refresh_colour()
+{
+    // Re-render the glyphs from the metrics atlas in the system colour
+    _colour = utils::get_system_colour();
+    _glyphs = _metrics.atlas().render_glyphs(_colour);
+    update();
+}
+
+//----------------------------------------------------------------------------
+// paintEvent
+//----------------------------------------------------------------------------
+void ParamValue::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    // Blit the value from the atlas, or draw it as text
+    if (_use_atlas) {
+        _metrics.atlas().draw(painter, _glyphs, 0, 0, _text);
+    }
+    else {
+        painter.setFont(font());
+        painter.setPen(_colour);
+        painter.drawText(rect(), (Qt::AlignLeft | Qt::AlignVCenter), _text);
+    }
+}
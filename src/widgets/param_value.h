@@ -0,0 +1,96 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  param_value.h
+ * @brief Param Value class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef PARAM_VALUE_H
+#define PARAM_VALUE_H
+
+#include <vector>
+#include <QWidget>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPixmap>
+#include <QSize>
+#include <QString>
+#include "dseg7_glyph_atlas.h"
+
+// Param Value layout - the display text and its size
+struct ParamValueLayout
+{
+    QString text;
+    bool numeric;
+    bool use_atlas;
+    uint text_font_index;
+    QSize size;
+};
+
+// Param Value Metrics class
+// Measures and elides param values without rendering anything, so it can be
+// used from any thread. Text values are shrunk to fit by choosing from a
+// fixed ladder of font sizes, and are only elided below the smallest size
+class ParamValueMetrics
+{
+public:
+    // Constructor
+    ParamValueMetrics();
+
+    // Public functions
+    const Dseg7GlyphAtlas& atlas() const;
+    const QFont& num_font() const;
+    const QFont& text_font(uint index=0) const;
+    ParamValueLayout value(const QString& value, int max_width) const;
+    ParamValueLayout text(const QString& text, int max_width) const;
+
+private:
+    // Private data
+    // Text font - a font in the ladder and its precomputed metrics
+    struct TextFont
+    {
+        QFont font;
+        QFontMetrics metrics;
+    };
+
+    // Private data
+    Dseg7GlyphAtlas _atlas;
+    std::vector<TextFont> _text_fonts;
+    bool _shrink_to_fit;
+
+    // Private functions
+    uint _fit_text_font(const QString& text, int max_width) const;
+};
+
+// Param Value class
+// Shows the big param value - numerical values are drawn from glyphs
+// pre-rendered from the metrics DSEG7 glyph atlas, and text values with the
+// standard font
+class ParamValue : public QWidget
+{
+    Q_OBJECT
+public:
+    // Constructor
+    explicit ParamValue(QWidget *parent = nullptr);
+
+    // Public functions
+    void set_value(const QString& value, int max_width);
+    void set_text(const QString& text, int max_width);
+    void set_layout(const ParamValueLayout& layout);
+    void refresh_colour();
+
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    // Private data
+    ParamValueMetrics _metrics;
+    QPixmap _glyphs;
+    QColor _colour;
+    QString _text;
+    bool _use_atlas;
+};
+
+#endif  // PARAM_VALUE_H
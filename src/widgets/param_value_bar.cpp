@@ -6,111 +6,133 @@
  * @brief Param Value Bar class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <QPaintEvent>
 #include "param_value_bar.h"
 #include "gui_common.h"
+#include "style_registry.h"
+#include "text_elider.h"
 #include "utils.h"
 
 // Constants
-constexpr uint PARAM_NAME_FONT_SIZE  = 32;
-constexpr uint PARAM_VALUE_FONT_SIZE = 32;
-constexpr uint PADDING               = 10;
-constexpr uint BOTTOM_BORDER_SIZE    = 1;
+constexpr uint PARAM_VALUE_BAR_FONT_SIZE = 32;
+constexpr uint PADDING                   = 10;
+constexpr uint BOTTOM_BORDER_SIZE        = 1;
+constexpr uint VALUE_BORDER_SIZE         = 1;
 
 //----------------------------------------------------------------------------
 // ParamValueBar
 //----------------------------------------------------------------------------
 ParamValueBar::ParamValueBar(QWidget *parent) : MoniqLabel(parent)
 {
-    // Create the param name
-    _param_name = new MoniqLabel(parent);
-	_param_name->setFont(QFont(STANDARD_FONT_NAME, PARAM_NAME_FONT_SIZE));
-    _param_name->setAlignment(Qt::AlignLeft|Qt::AlignVCenter);
-    _param_name->setText("TUNE");
-    _param_name->adjustSize();
-    _param_name->show();
-
-    // Create the param value
-    _param_value = new MoniqLabel(parent);
-	_param_value->setFont(QFont(STANDARD_FONT_NAME, PARAM_VALUE_FONT_SIZE));
-    _param_value->setAlignment(Qt::AlignLeft|Qt::AlignVCenter);
-    _param_value->setText("33");
-    _param_value->adjustSize();
-    _param_value->show();
-
-    // Refresh the colours and hide the bar
+    // The bar paints every pixel itself
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setFont(style_registry::font(STANDARD_FONT_NAME, PARAM_VALUE_BAR_FONT_SIZE));
+
+    // Lay out the initial param name and value
+    _param_name.setTextFormat(Qt::PlainText);
+    _set_text(_param_name, "TUNE", -1);
+    _param_value.setTextFormat(Qt::PlainText);
+    _set_text(_param_value, "33", -1);
+
+    // Refresh the colours
 	refresh_colour();
-    //hide();
 }
 
 //----------------------------------------------------------------------------
-// setGeometry
+// set_param_name
 //----------------------------------------------------------------------------
-void ParamValueBar::setGeometry(int x, int y, int w, int h)
+void ParamValueBar::set_param_name(const QString &name)
 {
-    auto max_width = ((w / 2) - (PADDING * 2));
-    
-    // Set the multi status bar geometry
-    MoniqLabel::setGeometry(x, y, w, h);
-
-    // Set the param name geometry
-    _param_name->setGeometry (x, y, (w / 2), (h - BOTTOM_BORDER_SIZE));
+    auto max_width = ((width() / 2) - (PADDING * 2));
 
-    // Set the param value geometry
-    _param_value->setGeometry ((x + (w / 2)), y, (w / 2), (h - BOTTOM_BORDER_SIZE));
+    // Update the param name
+    if (_set_text(_param_name, name, max_width)) {
+        update(_param_name_rect());
+    }
 }
 
 //----------------------------------------------------------------------------
-// show
+// set_param_value
 //----------------------------------------------------------------------------
-void ParamValueBar::show()
+void ParamValueBar::set_param_value(const QString& value)
 {
-    // Show the object
-    _param_name->show();
-    _param_value->show();
-    MoniqLabel::show();
+    auto max_width = ((width() / 2) - (PADDING * 2));
+
+    // Update the param value
+    if (_set_text(_param_value, value, max_width)) {
+        update(_param_value_rect());
+    }
 }
 
 //----------------------------------------------------------------------------
-// hide
+// refresh_colour
 //----------------------------------------------------------------------------
-void ParamValueBar::hide()
+void ParamValueBar::refresh_colour()
 {
-    // Hide the object
-    _param_name->hide();
-    _param_value->hide();
-    MoniqLabel::hide();
+    // The colours are read when painting, so just repaint the bar
+    update();
 }
 
 //----------------------------------------------------------------------------
-// set_param_name
+// paintEvent
 //----------------------------------------------------------------------------
-void ParamValueBar::set_param_name(const QString &name)
+void ParamValueBar::paintEvent(QPaintEvent *event)
 {
-    auto max_width = ((width() / 2) - (PADDING * 2));
+    QPainter painter(this);
 
-    // Update the param name
-    _param_name->set_text(name, max_width);
-    _param_name->setGeometry (x(), y(), (width() / 2), (height() - BOTTOM_BORDER_SIZE));    
+    // Clear the area being repainted - the system colour background forms
+    // the bottom border and the border between the name and value
+    painter.fillRect(event->rect(), utils::get_system_colour());
+
+    // Draw the param name and value if they need repainting
+    painter.setFont(font());
+    painter.setPen(utils::get_system_colour());
+    if (event->rect().intersects(_param_name_rect())) {
+        _draw_text(painter, _param_name, _param_name_rect());
+    }
+    if (event->rect().intersects(_param_value_rect())) {
+        _draw_text(painter, _param_value, _param_value_rect());
+    }
 }
 
 //----------------------------------------------------------------------------
-// set_param_value
+// _set_text
 //----------------------------------------------------------------------------
-void ParamValueBar::set_param_value(const QString& value)
+bool ParamValueBar::_set_text(QStaticText& static_text, const QString &text, int max_width)
 {
-    auto max_width = ((width() / 2) - (PADDING * 2));
+    // Elide the text, and only lay it out again if it has changed
+    auto elided = text_elider::elide(text, font(), max_width);
+    if (elided.text == static_text.text()) {
+        return false;
+    }
+    static_text.setText(elided.text);
+    static_text.prepare(QTransform(), font());
+    return true;
+}
 
-    // Update the param value
-    _param_value->set_text(value, max_width);
-    _param_value->setGeometry ((x() + (width() / 2)), y(), (width() / 2), (height() - BOTTOM_BORDER_SIZE));    
+//----------------------------------------------------------------------------
+// _param_name_rect
+//----------------------------------------------------------------------------
+QRect ParamValueBar::_param_name_rect() const
+{
+    return QRect(0, 0, (width() / 2), (height() - BOTTOM_BORDER_SIZE));
 }
 
 //----------------------------------------------------------------------------
-// refresh_colour
+// _param_value_rect
 //----------------------------------------------------------------------------
-void ParamValueBar::refresh_colour()
+QRect ParamValueBar::_param_value_rect() const
+{
+    // The param value is to the right of the border between the name and value
+    return QRect(((width() / 2) + VALUE_BORDER_SIZE), 0, ((width() / 2) - VALUE_BORDER_SIZE), (height() - BOTTOM_BORDER_SIZE));
+}
+
+//----------------------------------------------------------------------------
+// _draw_text
+//----------------------------------------------------------------------------
+void ParamValueBar::_draw_text(QPainter& painter, const QStaticText& static_text, const QRect& rect)
 {
-    _param_name->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str()  + "; padding-left: 10px; }");
-    _param_value->setStyleSheet("QLabel { background-color: black; color : " + utils::get_css_system_colour_str()  + "; padding-left: 10px; border-left-width: 0.5px; border-left-style: solid; border-left-color: " + utils::get_css_system_colour_str() + ";}");
-	setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; }"); 
+    // Draw the text left aligned and vertically centred, on a black background
+    painter.fillRect(rect, Qt::black);
+    painter.drawStaticText((rect.x() + PADDING), (rect.y() + ((rect.height() - static_text.size().height()) / 2)), static_text);
 }
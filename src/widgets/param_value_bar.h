@@ -9,11 +9,15 @@
 #ifndef PARAM_VALUE_BAR_H
 #define PARAM_VALUE_BAR_H
 
+#include <QPainter>
+#include <QStaticText>
 #include <QString>
 #include "moniq_label.h"
 #include "gui_msg.h"
 
 // Param Value Bar class
+// The bar is painted by the widget itself from the pre-laid out param name
+// and value, so a value change only repaints the value half of the bar
 class ParamValueBar: public MoniqLabel
 {
     Q_OBJECT
@@ -21,20 +25,25 @@ public:
     // Constructors
     explicit ParamValueBar(QWidget *parent = nullptr);
 
-    // Overriden functions
-    void setGeometry(int x, int y, int w, int h);
-    void show();
-    void hide();
-
     // Public functions
     void set_param_name(const QString &name);
     void set_param_value(const QString& value);
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     // Private data
-    MoniqLabel *_param_name;
-    MoniqLabel *_param_value;
+    QStaticText _param_name;
+    QStaticText _param_value;
+
+    // Private functions
+    bool _set_text(QStaticText& static_text, const QString &text, int max_width);
+    QRect _param_name_rect() const;
+    QRect _param_value_rect() const;
+    void _draw_text(QPainter& painter, const QStaticText& static_text, const QRect& rect);
 };
 
 #endif  // PARAM_VALUE_BAR_H
@@ -132,6 +132,33 @@ void Scope::set_pen_width(uint width)
     _pen_width = width;
 }
 
+//----------------------------------------------------------------------------
+// colour
+//----------------------------------------------------------------------------
+QColor Scope::colour() const
+{
+    // Return the scope colour
+    return _colour;
+}
+
+//----------------------------------------------------------------------------
+// pen_width
+//----------------------------------------------------------------------------
+uint Scope::pen_width() const
+{
+    // Return the pen width
+    return _pen_width;
+}
+
+//----------------------------------------------------------------------------
+// alpha
+//----------------------------------------------------------------------------
+float Scope::alpha() const
+{
+    // Return the alpha for the current display mode
+    return _alpha;
+}
+
 //----------------------------------------------------------------------------
 // refresh_data
 //----------------------------------------------------------------------------
@@ -251,11 +278,12 @@ void Scope::paintGL()
     glClear(GL_COLOR_BUFFER_BIT);
 
     // Update our line VBO vertices and draw it
+    // Note: The VBO is allocated in initializeGL, so just write the vertices
     QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
      QOpenGLVertexArrayObject::Binder vao_binder(&_vao);
     _program->bind();
     _vbo.bind();
-    _vbo.allocate(_vertices, (_num_samples * 3) * sizeof(GLfloat));
+    _vbo.write(0, _vertices, (_num_samples * 3) * sizeof(GLfloat));
     _vbo.release();
     _program->setUniformValue(_colour_loc, QVector4D(_colour.redF(), _colour.greenF(), _colour.blueF(), _alpha));
     f->glLineWidth(_pen_width);
@@ -52,6 +52,9 @@ public slots:
 
 protected:
 	// Protected functions
+	QColor colour() const;
+	uint pen_width() const;
+	float alpha() const;
     void initializeGL() override;
     void paintGL() override;
 
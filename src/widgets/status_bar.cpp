@@ -6,8 +6,14 @@
  * @brief Status Bar class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <algorithm>
+#include <QPainter>
+#include <QPaintEvent>
+#include <QRegion>
 #include "status_bar.h"
 #include "gui_common.h"
+#include "style_registry.h"
+#include "text_elider.h"
 #include "utils.h"
 
 // Constants
@@ -15,141 +21,93 @@ constexpr uint LEFT_STATUS_FONT_SIZE         = 35;
 constexpr uint TEMPO_STATUS_FONT_SIZE        = 30;
 constexpr uint SETUP_STATUS_FONT_SIZE        = 35;
 constexpr char MODIFIED_INDICATOR[]          = "*";
+constexpr char TEMPO_STATUS_TEMPLATE[]       = "000.0";
 constexpr uint MARGIN_LEFT                   = 20;
 constexpr uint MARGIN_RIGHT                  = 20;
 constexpr uint TWELEVE_VOICE_MODE_MARGIN_TOP = 3;
 constexpr uint LAYER_STATUS_MARGIN_TOP       = 0;
 constexpr uint TEMPO_STATUS_MARGIN_TOP       = 4;
+constexpr int TEMPO_STATUS_INTERVAL_MS       = 16;
 constexpr uint SPACING                       = 10;
+constexpr uint STATUS_PIXMAP_WIDTH           = 50;
+constexpr uint STATUS_PIXMAP_HEIGHT          = 60;
 
 //----------------------------------------------------------------------------
 // StatusBar
 //----------------------------------------------------------------------------
-StatusBar::StatusBar(QWidget *parent) : MoniqLabel(parent)
+StatusBar::StatusBar(QWidget *parent) : MoniqLabel(parent), _tempo_atlas(TEMPO_STATUS_FONT_SIZE)
 {
     // 12 voice mode off by default
     _left_status_text = "";
     _preset_modified = false;
     _12v_mode = false;
 
-    // Create the left status object
-    _left_status = new MoniqLabel(parent);
-	_left_status->setFont(QFont(STANDARD_FONT_NAME, LEFT_STATUS_FONT_SIZE));
-    _left_status->setAlignment(Qt::AlignLeft|Qt::AlignVCenter);
-    _left_status->setText("----");
-    _left_status->adjustSize();
-    _left_status->show();
-
-    // Create the preset status object
-    _preset_status = new MoniqLabel(parent);
-	_preset_status->setFont(QFont(STANDARD_FONT_NAME, SETUP_STATUS_FONT_SIZE));
-    _preset_status->setAlignment(Qt::AlignCenter);
-    _preset_status->setText(MODIFIED_INDICATOR);
-    _preset_status->adjustSize();
-    _preset_status->hide();
-
-    // Create the Layer voice status objects
-    _12v_mode_status = new MoniqLabel(parent);
-    auto image = QPixmap(TWELVE_VOICE_STATUS_PNG_RES);
-    image = image.scaled(50,60);
-    _12v_mode_status->setPixmap(image);
-    _12v_mode_status->adjustSize();
-    _12v_mode_status->hide();  
-    _l1_voice_status = new MoniqLabel(parent);
-    image = QPixmap(SIX_VOICE_ACTIVE_LAYER_PNG_RES);
-    image = image.scaled(50,60);
-    _l1_voice_status->setPixmap(image);
-    _l1_voice_status->adjustSize();
-    _l1_voice_status->hide();
-    _l2_voice_status = new MoniqLabel(parent);
-    image = QPixmap(ZERO_VOICE_INACTIVE_LAYER_PNG_RES);
-    image = image.scaled(50,60);
-    _l2_voice_status->setPixmap(image);
-    _l2_voice_status->adjustSize();
-    _l2_voice_status->hide();
-
-    // Create the Tempo status object
-    _tempo_status = new MoniqLabel(this);
-	_tempo_status->setFont(QFont(PARAM_VALUE_FONT_NAME, TEMPO_STATUS_FONT_SIZE));
-    _tempo_status->setAlignment(Qt::AlignCenter);
-    _tempo_status->setText("000.0");
-    _tempo_status->adjustSize();
-    _tempo_status->show();    
+    // The bar paints every pixel itself
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setFont(style_registry::font(STANDARD_FONT_NAME, LEFT_STATUS_FONT_SIZE));
+
+    // Lay out the initial left status and the preset status
+    _left_status.setTextFormat(Qt::PlainText);
+    _left_status.setText("----");
+    _left_status.prepare(QTransform(), font());
+    _left_status_width = style_registry::font_metrics(STANDARD_FONT_NAME, LEFT_STATUS_FONT_SIZE).horizontalAdvance("----");
+    _preset_status.setTextFormat(Qt::PlainText);
+    _preset_status.setText(MODIFIED_INDICATOR);
+    _preset_status.prepare(QTransform(), style_registry::font(STANDARD_FONT_NAME, SETUP_STATUS_FONT_SIZE));
+
+    // Render the tempo glyphs and set the initial tempo status - the tempo
+    // status is sized to fit the widest tempo
+    // Note: The glyphs are black on a transparent background, so they don't
+    // need to be re-rendered when the system colour changes
+    _tempo_atlas.render(Qt::black);
+    _tempo_status = TEMPO_STATUS_TEMPLATE;
+    _pending_tempo_status = TEMPO_STATUS_TEMPLATE;
+    _tempo_status_width = style_registry::font_metrics(PARAM_VALUE_FONT_NAME, TEMPO_STATUS_FONT_SIZE).horizontalAdvance(TEMPO_STATUS_TEMPLATE);
+
+    // Further tempo updates are held off until the next frame once a tempo
+    // has been shown
+    _tempo_status_timer.setInterval(TEMPO_STATUS_INTERVAL_MS);
+    _tempo_status_timer.setSingleShot(true);
+    connect(&_tempo_status_timer, &QTimer::timeout, this, &StatusBar::_show_pending_tempo);
+
+    // Load and scale the status pixmaps once - the Layer voice status is
+    // hidden until it is first set
+    _12v_mode_pixmap = QPixmap(TWELVE_VOICE_STATUS_PNG_RES).scaled(STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+    for (uint i=0; i<=MAX_LAYER_STATUS_VOICES; i++) {
+        _layer_status_pixmaps[false][i] = QPixmap(_get_layer_status_pixmap_path(false, i)).scaled(STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+        _layer_status_pixmaps[true][i] = QPixmap(_get_layer_status_pixmap_path(true, i)).scaled(STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+    }
+    _l1_voice_status = nullptr;
+    _l2_voice_status = nullptr;
 
     // Setup the status bar parameters
 	refresh_colour();
     show();
 }
 
-//----------------------------------------------------------------------------
-// setGeometry
-//----------------------------------------------------------------------------
-void StatusBar::setGeometry(int x, int y, int w, int h)
-{
-    // Set the status bar geometry
-    MoniqLabel::setGeometry(x, y, w, h);
-
-    // Set the left status geometry
-    _left_status->setGeometry ((x + MARGIN_LEFT), y, _left_status->width(), h);
-
-    // Set the tempo status geometry
-    _tempo_status->setGeometry ((w - _tempo_status->width() - MARGIN_RIGHT), 
-                                (y + TEMPO_STATUS_MARGIN_TOP), 
-                                _tempo_status->width(), 
-                                _tempo_status->height());
-
-    // Set the Layer voice status status geometry
-    _l2_voice_status->setGeometry ((w - _tempo_status->width() - SPACING - _l2_voice_status->width() - MARGIN_RIGHT), 
-                                   (y + LAYER_STATUS_MARGIN_TOP), 
-                                   _l2_voice_status->width(),
-                                   _l2_voice_status->height());
-    _l1_voice_status->setGeometry ((w - _tempo_status->width() - SPACING - _l2_voice_status->width() - _l1_voice_status->width() - MARGIN_RIGHT), 
-                                   (y + LAYER_STATUS_MARGIN_TOP), 
-                                   _l1_voice_status->width(),
-                                   _l1_voice_status->height());
-    _12v_mode_status->setGeometry ((w - _tempo_status->width() - SPACING - _l2_voice_status->width() - _l1_voice_status->width() - _12v_mode_status->width() - MARGIN_RIGHT), 
-                                   (y + TWELEVE_VOICE_MODE_MARGIN_TOP), 
-                                   _12v_mode_status->width(),
-                                   _12v_mode_status->height());                                                              
-}
-
 //----------------------------------------------------------------------------
 // set_left_status
 //----------------------------------------------------------------------------
 void StatusBar::set_left_status(const QString &status, bool modified)
 {
-    int twelve_note_mode_width = _12v_mode ? _12v_mode_status->width() : 0;
-    auto max_width = (width() - MARGIN_LEFT - SPACING - twelve_note_mode_width - _l2_voice_status->width() - _l1_voice_status->width() - SPACING - _tempo_status->width() - MARGIN_RIGHT);
+    auto rect = _left_status_rect();
+    int max_width = rect.width() - MARGIN_LEFT;
 
-    // Has the setup been modified?
+    // Has the setup been modified? If so, allow for the setup status indicator
     if (modified) {
-        // Show the setup status indicator
-        _preset_status->show();
-        max_width -= _preset_status->width();
-    }
-    else {
-        // Hide the setup status indicator
-        _preset_status->hide();
+        max_width -= _preset_status.size().width();
     }
 
-    // Show the left status
-    _left_status->set_text(status, max_width);
-    _left_status->setGeometry (MARGIN_LEFT, 
-                               y(), 
-                               _left_status->width(), 
-                               height());
-    
-    // If the setup was modified, set the setup geometry
-    if (modified) {
-        _preset_status->setGeometry (MARGIN_LEFT + _left_status->width(), 
-                                     y(), 
-                                     _preset_status->width(), 
-                                     height());
-    }
+    // Lay out the left status
+    auto elided = text_elider::elide(status, font(), max_width);
+    _left_status.setText(elided.text);
+    _left_status.prepare(QTransform(), font());
+    _left_status_width = elided.width;
 
     // Save the status text and preset modified state in case we need to update the left status
     _left_status_text = status;
     _preset_modified = modified;
+    update(rect);
 }
 
 //----------------------------------------------------------------------------
@@ -157,32 +115,27 @@ void StatusBar::set_left_status(const QString &status, bool modified)
 //----------------------------------------------------------------------------
 void StatusBar::set_layer_status(Layer current_layer, bool twelve_note_mode, uint l1_voices, uint l2_voices)
 {
-    QString path;
-    bool twelve_note_mode_changed = _12v_mode != twelve_note_mode;
-
-    // Set the 12 voice mode
-    _12v_mode = twelve_note_mode;
-
     // Was the 12 voice mode changed?
-    if (twelve_note_mode_changed) {
+    // If so, the left status is re-laid out as the space available for it changes
+    if (_12v_mode != twelve_note_mode) {
+        update(_left_status_rect() | _12v_mode_rect());
+        _12v_mode = twelve_note_mode;
         set_left_status(_left_status_text, _preset_modified);
     }
 
-    _12v_mode ?
-        _12v_mode_status->show() :
-        _12v_mode_status->hide();
-
     // Set the L1 status based on the number of voices
-    auto image = QPixmap(_get_layer_status_pixmap_path((current_layer == Layer::LAYER_1), l1_voices));
-    image = image.scaled(50,60);
-    _l1_voice_status->setPixmap(image);
-    _l1_voice_status->show();
+    auto pixmap = _get_layer_status_pixmap((current_layer == Layer::LAYER_1), l1_voices);
+    if (pixmap != _l1_voice_status) {
+        _l1_voice_status = pixmap;
+        update(_l1_voice_status_rect());
+    }
 
     // Set the L2 status based on the number of voices
-    image = QPixmap(_get_layer_status_pixmap_path((current_layer == Layer::LAYER_2), l2_voices));
-    image = image.scaled(50,60);
-    _l2_voice_status->setPixmap(image);
-    _l2_voice_status->show();
+    pixmap = _get_layer_status_pixmap((current_layer == Layer::LAYER_2), l2_voices);
+    if (pixmap != _l2_voice_status) {
+        _l2_voice_status = pixmap;
+        update(_l2_voice_status_rect());
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -190,8 +143,13 @@ void StatusBar::set_layer_status(Layer current_layer, bool twelve_note_mode, uin
 //----------------------------------------------------------------------------
 void StatusBar::set_tempo(const QString& tempo)
 {
-    // Set the tempo
-    _tempo_status->setText(tempo);
+    // Save the tempo to show, and show it now if a tempo has not already
+    // been shown this frame
+    // If it has, the latest tempo is shown when the frame timer expires
+    _pending_tempo_status = tempo;
+    if (!_tempo_status_timer.isActive()) {
+        _show_pending_tempo();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -199,11 +157,166 @@ void StatusBar::set_tempo(const QString& tempo)
 //----------------------------------------------------------------------------
 void StatusBar::refresh_colour()
 {
-    // Refresh the status bar object colours
-	_left_status->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }");
-    _preset_status->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }");
-    _tempo_status->setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }"); 
-	setStyleSheet("QLabel { background-color: " + utils::get_css_system_colour_str() + "; color : black; }"); 
+    // The colours are read when painting, so just repaint the status bar
+    update();
+}
+
+//----------------------------------------------------------------------------
+// paintEvent
+//----------------------------------------------------------------------------
+void StatusBar::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+
+    // Clear the area being repainted - the status bar is black text on the
+    // system colour
+    painter.fillRect(event->rect(), utils::get_system_colour());
+    painter.setPen(Qt::black);
+
+    // Draw the left status, followed by the setup status indicator if the
+    // setup has been modified
+    auto rect = _left_status_rect();
+    if (event->rect().intersects(rect)) {
+        painter.setClipRect(rect);
+        painter.setFont(font());
+        painter.drawStaticText(MARGIN_LEFT, ((height() - _left_status.size().height()) / 2), _left_status);
+        if (_preset_modified) {
+            painter.drawStaticText((MARGIN_LEFT + _left_status_width), ((height() - _preset_status.size().height()) / 2), _preset_status);
+        }
+        painter.setClipping(false);
+    }
+
+    // Draw the 12 voice mode and Layer voice status pixmaps
+    if (_12v_mode && event->rect().intersects(_12v_mode_rect())) {
+        painter.drawPixmap(_12v_mode_rect().topLeft(), _12v_mode_pixmap);
+    }
+    if (_l1_voice_status && event->rect().intersects(_l1_voice_status_rect())) {
+        painter.drawPixmap(_l1_voice_status_rect().topLeft(), *_l1_voice_status);
+    }
+    if (_l2_voice_status && event->rect().intersects(_l2_voice_status_rect())) {
+        painter.drawPixmap(_l2_voice_status_rect().topLeft(), *_l2_voice_status);
+    }
+
+    // Draw the tempo status, centred in its area
+    // Note: The tempo glyphs are blitted from the atlas, unless the tempo
+    // contains a character not in the atlas
+    rect = _tempo_status_rect();
+    if (event->rect().intersects(rect)) {
+        if (_tempo_atlas.contains(_tempo_status)) {
+            _tempo_atlas.draw(painter, _tempo_status_x(_tempo_status), rect.y(), _tempo_status);
+        }
+        else {
+            painter.setFont(_tempo_atlas.font());
+            painter.drawText(rect, Qt::AlignCenter, _tempo_status);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------
+// _left_status_rect
+//----------------------------------------------------------------------------
+QRect StatusBar::_left_status_rect() const
+{
+    // The left status fills the space to the left of the status pixmaps
+    int right = (_12v_mode ? _12v_mode_rect().left() : _l1_voice_status_rect().left()) - SPACING;
+    return QRect(0, 0, right, height());
+}
+
+//----------------------------------------------------------------------------
+// _12v_mode_rect
+//----------------------------------------------------------------------------
+QRect StatusBar::_12v_mode_rect() const
+{
+    return QRect((_l1_voice_status_rect().left() - STATUS_PIXMAP_WIDTH), TWELEVE_VOICE_MODE_MARGIN_TOP, STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+}
+
+//----------------------------------------------------------------------------
+// _l1_voice_status_rect
+//----------------------------------------------------------------------------
+QRect StatusBar::_l1_voice_status_rect() const
+{
+    return QRect((_l2_voice_status_rect().left() - STATUS_PIXMAP_WIDTH), LAYER_STATUS_MARGIN_TOP, STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+}
+
+//----------------------------------------------------------------------------
+// _l2_voice_status_rect
+//----------------------------------------------------------------------------
+QRect StatusBar::_l2_voice_status_rect() const
+{
+    return QRect((_tempo_status_rect().left() - SPACING - STATUS_PIXMAP_WIDTH), LAYER_STATUS_MARGIN_TOP, STATUS_PIXMAP_WIDTH, STATUS_PIXMAP_HEIGHT);
+}
+
+//----------------------------------------------------------------------------
+// _tempo_status_rect
+//----------------------------------------------------------------------------
+QRect StatusBar::_tempo_status_rect() const
+{
+    return QRect((width() - _tempo_status_width - MARGIN_RIGHT), TEMPO_STATUS_MARGIN_TOP, _tempo_status_width, _tempo_atlas.height());
+}
+
+//----------------------------------------------------------------------------
+// _tempo_status_x
+//----------------------------------------------------------------------------
+int StatusBar::_tempo_status_x(const QString& tempo) const
+{
+    // The tempo is centred in the tempo status area
+    // Note: Assumes the tempo only contains glyphs in the atlas
+    auto rect = _tempo_status_rect();
+    return rect.x() + ((rect.width() - _tempo_atlas.text_width(tempo)) / 2);
+}
+
+//----------------------------------------------------------------------------
+// _show_pending_tempo
+//----------------------------------------------------------------------------
+void StatusBar::_show_pending_tempo()
+{
+    // Skip the tempo if it is unchanged - there is then nothing to hold off
+    // until the next frame
+    if (_pending_tempo_status == _tempo_status) {
+        return;
+    }
+
+    // Can the tempo be drawn from the atlas?
+    auto rect = _tempo_status_rect();
+    if (_tempo_atlas.contains(_tempo_status) && _tempo_atlas.contains(_pending_tempo_status)) {
+        // Repaint only the glyphs that have changed, or moved
+        // Note: Both the old and new glyph areas are repainted, so that the old
+        // glyph is cleared
+        QRegion region;
+        int old_x = _tempo_status_x(_tempo_status);
+        int new_x = _tempo_status_x(_pending_tempo_status);
+        int num_glyphs = std::max(_tempo_status.size(), _pending_tempo_status.size());
+        for (int i=0; i<num_glyphs; i++) {
+            // A glyph missing from either tempo is always treated as changed
+            bool in_old = i < _tempo_status.size();
+            bool in_new = i < _pending_tempo_status.size();
+            QRect old_rect = in_old ? _tempo_atlas.glyph_rect(_tempo_status, i).translated(old_x, rect.y()) : QRect();
+            QRect new_rect = in_new ? _tempo_atlas.glyph_rect(_pending_tempo_status, i).translated(new_x, rect.y()) : QRect();
+            bool changed = !in_old || !in_new || (_tempo_status.at(i) != _pending_tempo_status.at(i));
+            if (changed || (old_rect != new_rect)) {
+                region += old_rect;
+                region += new_rect;
+            }
+        }
+        update(region);
+    }
+    else {
+        // Repaint the whole tempo status
+        update(rect);
+    }
+
+    // Show the tempo, and hold off any further tempo updates until the next frame
+    _tempo_status = _pending_tempo_status;
+    _tempo_status_timer.start();
+}
+
+//----------------------------------------------------------------------------
+// _get_layer_status_pixmap
+//----------------------------------------------------------------------------
+const QPixmap *StatusBar::_get_layer_status_pixmap(bool current_layer, uint num_voices) const
+{
+    // Return the pre-scaled pixmap for the number of voices, if any
+    return (num_voices <= MAX_LAYER_STATUS_VOICES) ? &_layer_status_pixmaps[current_layer][num_voices] : nullptr;
 }
 
 //----------------------------------------------------------------------------
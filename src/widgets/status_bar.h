@@ -9,11 +9,24 @@
 #ifndef STATUS_BAR_H
 #define STATUS_BAR_H
 
+#include <QPixmap>
+#include <QStaticText>
 #include <QString>
+#include <QTimer>
 #include "moniq_label.h"
+#include "dseg7_glyph_atlas.h"
 #include "gui_msg.h"
 
+// Constants
+constexpr uint MAX_LAYER_STATUS_VOICES = 6;
+
 // Status Bar class
+// The status bar is painted by the widget itself from pre-laid out text and
+// pre-scaled status pixmaps, so each status change only repaints the area
+// it affects
+// The tempo can be updated at a high rate from an external MIDI clock, so it
+// is shown at most once per frame, and only the changed digits are repainted
+// from a DSEG7 glyph atlas
 class StatusBar: public MoniqLabel
 {
     Q_OBJECT
@@ -21,28 +34,43 @@ public:
     // Constructors
     explicit StatusBar(QWidget *parent = nullptr);
 
-    // Overriden functions
-    void setGeometry(int x, int y, int w, int h);
-
     // Public functions
     void set_left_status(const QString &status, bool modified=false);
     void set_layer_status(Layer current_layer, bool twelve_note_mode, uint l1_voices, uint l2_voices);
     void set_tempo(const QString& tempo);    
     void refresh_colour();
 
+protected:
+    // Protected functions
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     // Private data
-    MoniqLabel *_left_status;
-    MoniqLabel *_preset_status;
-    MoniqLabel *_12v_mode_status;
-    MoniqLabel *_l1_voice_status;
-    MoniqLabel *_l2_voice_status;
-    MoniqLabel *_tempo_status;
+    QStaticText _left_status;
+    QStaticText _preset_status;
+    Dseg7GlyphAtlas _tempo_atlas;
+    QString _tempo_status;
+    QString _pending_tempo_status;
+    QTimer _tempo_status_timer;
+    int _left_status_width;
+    int _tempo_status_width;
+    QPixmap _12v_mode_pixmap;
+    QPixmap _layer_status_pixmaps[2][MAX_LAYER_STATUS_VOICES + 1];
+    const QPixmap *_l1_voice_status;
+    const QPixmap *_l2_voice_status;
     QString _left_status_text;
     bool _preset_modified;
     bool _12v_mode;
 
     // Private functions
+    QRect _left_status_rect() const;
+    QRect _12v_mode_rect() const;
+    QRect _l1_voice_status_rect() const;
+    QRect _l2_voice_status_rect() const;
+    QRect _tempo_status_rect() const;
+    int _tempo_status_x(const QString& tempo) const;
+    void _show_pending_tempo();
+    const QPixmap *_get_layer_status_pixmap(bool current_layer, uint num_voices) const;
     QString _get_layer_status_pixmap_path(bool current_layer, uint num_voices);
 };
 
@@ -0,0 +1,321 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  wav_reader.cpp
+ * @brief WAV Reader implementation.
+ *-----------------------------------------------------------------------------
+ */
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "wav_reader.h"
+
+// Constants
+constexpr uint RIFF_HEADER_SIZE           = 12;
+constexpr uint CHUNK_HEADER_SIZE          = 8;
+constexpr uint FMT_CHUNK_MIN_SIZE         = 16;
+constexpr uint FMT_EXTENSIBLE_MIN_SIZE    = 40;
+constexpr uint FMT_EXTENSIBLE_SUBFMT_OFS  = 24;
+constexpr uint WAVE_FORMAT_PCM            = 0x0001;
+constexpr uint WAVE_FORMAT_IEEE_FLOAT     = 0x0003;
+constexpr uint WAVE_FORMAT_EXTENSIBLE     = 0xFFFE;
+constexpr float PCM_8_SCALE               = 1.0f / 128.0f;
+constexpr float PCM_16_SCALE              = 1.0f / 32768.0f;
+constexpr float PCM_24_SCALE              = 1.0f / 8388608.0f;
+constexpr float PCM_32_SCALE              = 1.0f / 2147483648.0f;
+
+// Little-endian helpers
+static inline uint _read_u16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+static inline uint _read_u32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint)p[3] << 24); }
+
+//----------------------------------------------------------------------------
+// WavReader
+//----------------------------------------------------------------------------
+WavReader::WavReader()
+{
+    // Initialise the private data
+    _fd = -1;
+    _map = nullptr;
+    _map_size = 0;
+    _sample_data = nullptr;
+    _format = WavSampleFormat::UNSUPPORTED;
+    _num_channels = 0;
+    _num_frames = 0;
+    _bytes_per_sample = 0;
+    _frame_size = 0;
+}
+
+//----------------------------------------------------------------------------
+// ~WavReader
+//----------------------------------------------------------------------------
+WavReader::~WavReader()
+{
+    // Make sure the file is closed
+    close();
+}
+
+//----------------------------------------------------------------------------
+// open
+//----------------------------------------------------------------------------
+bool WavReader::open(const std::string& filename)
+{
+    struct stat st;
+
+    // Close any previously opened file
+    close();
+
+    // Open and map the file - the header is parsed from the mapping, and the
+    // sample data is only paged in as it is read
+    _fd = ::open(filename.c_str(), O_RDONLY);
+    if (_fd == -1) {
+        return false;
+    }
+    if ((::fstat(_fd, &st) != 0) || (st.st_size < (RIFF_HEADER_SIZE + CHUNK_HEADER_SIZE))) {
+        close();
+        return false;
+    }
+    _map_size = st.st_size;
+    void *map = ::mmap(nullptr, _map_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (map == MAP_FAILED) {
+        _map_size = 0;
+        close();
+        return false;
+    }
+    _map = static_cast<uint8_t *>(map);
+
+    // Parse the RIFF header
+    if (!_parse_header()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// close
+//----------------------------------------------------------------------------
+void WavReader::close()
+{
+    // Unmap and close the file if open
+    if (_map) {
+        ::munmap(_map, _map_size);
+    }
+    if (_fd != -1) {
+        ::close(_fd);
+    }
+    _fd = -1;
+    _map = nullptr;
+    _map_size = 0;
+    _sample_data = nullptr;
+    _format = WavSampleFormat::UNSUPPORTED;
+    _num_channels = 0;
+    _num_frames = 0;
+    _bytes_per_sample = 0;
+    _frame_size = 0;
+}
+
+//----------------------------------------------------------------------------
+// num_channels
+//----------------------------------------------------------------------------
+uint WavReader::num_channels() const
+{
+    return _num_channels;
+}
+
+//----------------------------------------------------------------------------
+// num_frames
+//----------------------------------------------------------------------------
+uint WavReader::num_frames() const
+{
+    return _num_frames;
+}
+
+//----------------------------------------------------------------------------
+// sample_format
+//----------------------------------------------------------------------------
+WavSampleFormat WavReader::sample_format() const
+{
+    return _format;
+}
+
+//----------------------------------------------------------------------------
+// read_samples
+//----------------------------------------------------------------------------
+uint WavReader::read_samples(uint channel, uint start_frame, uint num_samples, float *samples) const
+{
+    // Check the request is valid
+    if ((_sample_data == nullptr) || (channel >= _num_channels) || (start_frame >= _num_frames)) {
+        return 0;
+    }
+
+    // Clip the number of samples to what is available in the file
+    uint available = _num_frames - start_frame;
+    if (num_samples > available) {
+        num_samples = available;
+    }
+
+    // Convert only the requested samples - the format switch is kept outside
+    // of the sample loops
+    const uint8_t *src = _sample_data + ((size_t)start_frame * _frame_size) + (channel * _bytes_per_sample);
+    const size_t src_inc = _frame_size;
+    switch (_format) {
+        case WavSampleFormat::PCM_8:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                samples[i] = ((int)src[0] - 128) * PCM_8_SCALE;
+            }
+            break;
+
+        case WavSampleFormat::PCM_16:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                samples[i] = (int16_t)_read_u16(src) * PCM_16_SCALE;
+            }
+            break;
+
+        case WavSampleFormat::PCM_24:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                // Shift into the top 24 bits of a 32-bit int to sign extend
+                int32_t sample = (int32_t)(((uint32_t)src[0] << 8) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 24)) >> 8;
+                samples[i] = sample * PCM_24_SCALE;
+            }
+            break;
+
+        case WavSampleFormat::PCM_32:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                samples[i] = (int32_t)_read_u32(src) * PCM_32_SCALE;
+            }
+            break;
+
+        case WavSampleFormat::FLOAT_32:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                float sample;
+                std::memcpy(&sample, src, sizeof(sample));
+                samples[i] = sample;
+            }
+            break;
+
+        case WavSampleFormat::FLOAT_64:
+            for (uint i=0; i<num_samples; i++, src+=src_inc) {
+                double sample;
+                std::memcpy(&sample, src, sizeof(sample));
+                samples[i] = (float)sample;
+            }
+            break;
+
+        default:
+            return 0;
+    }
+    return num_samples;
+}
+
+//----------------------------------------------------------------------------
+// _parse_header
+//----------------------------------------------------------------------------
+bool WavReader::_parse_header()
+{
+    const uint8_t *fmt = nullptr;
+    uint fmt_size = 0;
+    const uint8_t *data = nullptr;
+    size_t data_size = 0;
+
+    // Check the RIFF/WAVE header
+    if ((std::memcmp(_map, "RIFF", 4) != 0) || (std::memcmp(_map + 8, "WAVE", 4) != 0)) {
+        return false;
+    }
+
+    // Walk the chunks looking for the format and data chunks
+    size_t pos = RIFF_HEADER_SIZE;
+    while ((pos + CHUNK_HEADER_SIZE) <= _map_size) {
+        const uint8_t *chunk = _map + pos;
+        size_t chunk_size = _read_u32(chunk + 4);
+        size_t chunk_available = _map_size - pos - CHUNK_HEADER_SIZE;
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunk_size > chunk_available) {
+                return false;
+            }
+            fmt = chunk + CHUNK_HEADER_SIZE;
+            fmt_size = chunk_size;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            // Allow for truncated files (or a streamed size of 0xFFFFFFFF) by
+            // clipping the data to what is actually in the file
+            data = chunk + CHUNK_HEADER_SIZE;
+            data_size = (chunk_size > chunk_available) ? chunk_available : chunk_size;
+        }
+        if (fmt && data) {
+            break;
+        }
+
+        // Stop at a chunk that runs past the end of the file - skipping it
+        // could wrap the position back to an earlier chunk
+        if (chunk_size > chunk_available) {
+            break;
+        }
+
+        // Chunks are word aligned
+        pos += CHUNK_HEADER_SIZE + chunk_size + (chunk_size & 1);
+    }
+    if ((fmt == nullptr) || (data == nullptr) || (fmt_size < FMT_CHUNK_MIN_SIZE)) {
+        return false;
+    }
+
+    // Parse the format chunk
+    uint format_tag = _read_u16(fmt);
+    uint num_channels = _read_u16(fmt + 2);
+    uint block_align = _read_u16(fmt + 12);
+    uint bits_per_sample = _read_u16(fmt + 14);
+    if ((format_tag == WAVE_FORMAT_EXTENSIBLE) && (fmt_size >= FMT_EXTENSIBLE_MIN_SIZE)) {
+        // The actual format is held in the first two bytes of the sub-format GUID
+        format_tag = _read_u16(fmt + FMT_EXTENSIBLE_SUBFMT_OFS);
+    }
+    auto format = _get_sample_format(format_tag, bits_per_sample);
+    uint bytes_per_sample = bits_per_sample / 8;
+    if ((format == WavSampleFormat::UNSUPPORTED) || (num_channels == 0) || (block_align < (num_channels * bytes_per_sample))) {
+        return false;
+    }
+
+    // Header parsed OK
+    _format = format;
+    _num_channels = num_channels;
+    _bytes_per_sample = bytes_per_sample;
+    _frame_size = block_align;
+    _num_frames = data_size / block_align;
+    _sample_data = data;
+    return true;
+}
+
+//----------------------------------------------------------------------------
+// _get_sample_format
+//----------------------------------------------------------------------------
+WavSampleFormat WavReader::_get_sample_format(uint format_tag, uint bits_per_sample) const
+{
+    // Get the sample format from the format tag and bits per sample
+    if (format_tag == WAVE_FORMAT_PCM) {
+        switch (bits_per_sample) {
+            case 8:
+                return WavSampleFormat::PCM_8;
+            case 16:
+                return WavSampleFormat::PCM_16;
+            case 24:
+                return WavSampleFormat::PCM_24;
+            case 32:
+                return WavSampleFormat::PCM_32;
+            default:
+                break;
+        }
+    }
+    else if (format_tag == WAVE_FORMAT_IEEE_FLOAT) {
+        switch (bits_per_sample) {
+            case 32:
+                return WavSampleFormat::FLOAT_32;
+            case 64:
+                return WavSampleFormat::FLOAT_64;
+            default:
+                break;
+        }
+    }
+    return WavSampleFormat::UNSUPPORTED;
+}
@@ -0,0 +1,67 @@
+/**
+ *-----------------------------------------------------------------------------
+ * Copyright (c) 2024 Melbourne Instruments, Australia
+ *-----------------------------------------------------------------------------
+ * @file  wav_reader.h
+ * @brief WAV Reader class definitions.
+ *-----------------------------------------------------------------------------
+ */
+#ifndef _WAV_READER_H
+#define _WAV_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+// WAV sample formats supported by the reader
+enum class WavSampleFormat
+{
+    UNSUPPORTED,
+    PCM_8,
+    PCM_16,
+    PCM_24,
+    PCM_32,
+    FLOAT_32,
+    FLOAT_64
+};
+
+// WAV Reader class
+// Maps a WAV file and parses the RIFF header only, so that callers can
+// validate the file dimensions before any sample data is converted, and
+// then convert only the samples they need
+class WavReader
+{
+public:
+    // Constructor
+    WavReader();
+
+    // Destructor
+    virtual ~WavReader();
+
+    // Public functions
+    bool open(const std::string& filename);
+    void close();
+    uint num_channels() const;
+    uint num_frames() const;
+    WavSampleFormat sample_format() const;
+    uint read_samples(uint channel, uint start_frame, uint num_samples, float *samples) const;
+
+private:
+    // Private data
+    int _fd;
+    uint8_t *_map;
+    size_t _map_size;
+    const uint8_t *_sample_data;
+    WavSampleFormat _format;
+    uint _num_channels;
+    uint _num_frames;
+    uint _bytes_per_sample;
+    uint _frame_size;
+
+    // Private functions
+    bool _parse_header();
+    WavSampleFormat _get_sample_format(uint format_tag, uint bits_per_sample) const;
+};
+
+#endif  // _WAV_READER_H
@@ -8,7 +8,14 @@
  */
 
 #include <stdint.h>
+#include <algorithm>
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#endif
 #include "wt_file.h"
+#include "wav_reader.h"
 #include "gui_common.h"
 
 // Constants
@@ -17,28 +24,38 @@ constexpr char WT_FILE_EXT[]          = ".wav";
 constexpr uint MAX_NUM_WAVES          = 256;
 constexpr uint WAVE_LENGTH            = (1024 * 2);
 constexpr uint WAVE_DOWNSAMPLING_RATE = 8;
+constexpr uint NUM_ENVELOPE_COLUMNS   = (WAVE_LENGTH / WAVE_DOWNSAMPLING_RATE) / 2;
+constexpr uint ENVELOPE_BUCKET_SIZE   = WAVE_LENGTH / NUM_ENVELOPE_COLUMNS;
 constexpr float WT_DISPLAY_TIME       = std::chrono::milliseconds(2000).count();
 
+// The envelope buckets are processed 4 samples at a time
+static_assert((ENVELOPE_BUCKET_SIZE % 4) == 0, "Envelope bucket size must be a multiple of 4");
+
 //----------------------------------------------------------------------------
 // NumSamples
 //----------------------------------------------------------------------------
 uint WtFile::NumSamplesPerWave()
 {
-    // Return the number of samples per wave
+    // Return the number of samples per wave - this is a min/max pair for
+    // each envelope column
     return WAVE_LENGTH / WAVE_DOWNSAMPLING_RATE;
 }
 
+//----------------------------------------------------------------------------
+// MaxNumWaves
+//----------------------------------------------------------------------------
+uint WtFile::MaxNumWaves()
+{
+    // Return the maximum number of waves in a wavetable
+    return MAX_NUM_WAVES;
+}
+
 //----------------------------------------------------------------------------
 // WtFile
 //----------------------------------------------------------------------------
 WtFile::WtFile()
 {
     // Initialise the private data
-    _loaded = false;
-    _num_waves = 0;
-    _wave_index = 0;
-    _parse_fwd = true;
-    _wave_time = 0;
     _wavetable_time = 0;
 }
 
@@ -55,38 +72,45 @@ WtFile::~WtFile()
 //----------------------------------------------------------------------------
 bool WtFile::load(std::string filename)
 {
-    // Get the mutex lock
-	std::unique_lock<std::mutex> lk(_mutex);
-
-    // Try and load the WT
+    // Try and open the WT - only the header is parsed at this point
+    // Note: Any current WT is unloaded first
     auto filename_path = MONIQ_WT_DIR + filename + WT_FILE_EXT;
-    _loaded = false;
-    if (!_file.load(filename_path)) {
+    WavReader reader;
+    unload();
+    if (!reader.open(filename_path)) {
         MSG("Could not open the wavetable file: " << filename_path);
         return false;
     }
 
     // Check the number of samples is valid
-    if ((_file.getNumChannels() == 0) || (_file.samples[0].size() % WAVE_LENGTH)) {
+    if ((reader.num_channels() == 0) || (reader.num_frames() == 0) || (reader.num_frames() % WAVE_LENGTH)) {
         MSG("Wavetable number of channels/samples is invalid: " << filename_path);
         return false;
     }
 
     // Get the number of waves and check it is valid
-    auto num_waves = _file.samples[0].size() / WAVE_LENGTH;
+    auto num_waves = reader.num_frames() / WAVE_LENGTH;
     if (num_waves > MAX_NUM_WAVES) {
         MSG("Wavetable number of channels/samples is invalid: " << filename_path);
         return false;
     }
 
-    // WT loaded
-    _loaded = true;
-    _num_waves = num_waves;
-    _wave_index = 0;
-    _samples = _file.samples[0].data();
-    _wave_time = WT_DISPLAY_TIME / _num_waves;
-    _wavetable_time = 0.0f;
-    _parse_fwd = true;
+    // Read each wave (channel 0 only) and decimate it to its min/max envelope
+    float wave[WAVE_LENGTH];
+    auto table = std::make_shared<WtTable>();
+    table->num_waves = num_waves;
+    table->samples.resize(num_waves * NumSamplesPerWave());
+    for (uint i=0; i<num_waves; i++) {
+        if (reader.read_samples(0, (i * WAVE_LENGTH), WAVE_LENGTH, wave) != WAVE_LENGTH) {
+            MSG("Could not read the wavetable file samples: " << filename_path);
+            return false;
+        }
+        _decimate_wave(wave, (table->samples.data() + (i * NumSamplesPerWave())));
+    }
+
+    // WT loaded - publish the table, the animation is restarted when it is
+    // next stepped
+    std::atomic_store(&_table, std::shared_ptr<const WtTable>(table));
     return true;
 }
 
@@ -95,82 +119,125 @@ bool WtFile::load(std::string filename)
 //----------------------------------------------------------------------------
 void WtFile::unload()
 {
-    // Get the mutex lock
-	std::unique_lock<std::mutex> lk(_mutex);
-    
     // This just indicates the WT is no longer loaded
-    _loaded = false;
+    std::atomic_store(&_table, std::shared_ptr<const WtTable>());
+}
+
+//----------------------------------------------------------------------------
+// table
+//----------------------------------------------------------------------------
+std::shared_ptr<const WtTable> WtFile::table() const
+{
+    // Return a snapshot of the loaded wavetable (if any)
+    return std::atomic_load(&_table);
+}
+
+//----------------------------------------------------------------------------
+// next_morph_pos
+//----------------------------------------------------------------------------
+bool WtFile::next_morph_pos(float& morph_pos)
+{
+    // Get a snapshot of the loaded wavetable
+    auto table = std::atomic_load(&_table);
+    if (!table) {
+        _current_table.reset();
+        return false;
+    }
+
+    // If this is a newly loaded wavetable, restart the animation
+    if (table != _current_table) {
+        _current_table = table;
+        _wavetable_time = 0.0f;
+    }
+
+    // The morph position sweeps forward through the waves and then back again,
+    // and is continuous so that the scope can blend between adjacent waves
+    float phase = _wavetable_time / WT_DISPLAY_TIME;
+    if (phase > 1.0f) {
+        phase = 2.0f - phase;
+    }
+    morph_pos = phase * (table->num_waves - 1);
+
+    // Increment the total wavetable time by the refresh rate, wrapping at the
+    // end of each forward/reverse cycle
+    _wavetable_time += WT_CHART_REFRESH_RATE;
+    if (_wavetable_time >= (WT_DISPLAY_TIME * 2)) {
+        _wavetable_time -= (WT_DISPLAY_TIME * 2);
+    }
+    return true;
 }
 
 //----------------------------------------------------------------------------
-// next_wave_samples
+// _decimate_wave
 //----------------------------------------------------------------------------
-std::vector<float> WtFile::next_wave_samples()
+void WtFile::_decimate_wave(const float *wave, float *envelope)
 {
-    std::vector<float> samples;
-    
-    // Get the mutex lock
-	std::unique_lock<std::mutex> lk(_mutex);
-
-    // If a wavetable is loaded
-    if (_loaded) {
-        // Calculate the wave index increment based on the cumulative wavtable time
-        uint inc = std::round(_wavetable_time / _wave_time) - _wave_index;
-
-        // Increment the total wavetable time by the refresh rate
-        _wavetable_time += WT_CHART_REFRESH_RATE;
-
-        // If the increment value is zero, skip this processing and return
-        // no sample data
-        if (inc) {
-            // Get the next wave samples - down sampled
-            for (uint i=0; i<(WAVE_LENGTH / WAVE_DOWNSAMPLING_RATE); i++) {
-                samples.push_back(*_samples);
-                _samples += WAVE_DOWNSAMPLING_RATE;
-            }
-
-            // Are we parsing the wavetable in a forward direction?
-            if (_parse_fwd) {
-                // Increment the wave index
-                _wave_index += inc;
-
-                // Have we reached the end of the wavetable?
-                if (_wave_index >= _num_waves) {
-                    // Reached the end of the waves, switch to reverse parsing
-                    _wave_index = (_num_waves - 1);
-                    _samples = _file.samples[0].data() + _file.samples[0].size() - WAVE_LENGTH;
-                    _parse_fwd = false;
-                }
-                else {
-                    // Increment the samples pointer if needed - if the increment
-                    // is greater than 1
-                    if (inc > 1) {
-                        _samples += (WAVE_LENGTH * (inc - 1));
-                    }
-                }
-            }
-            else {
-                // Decrement the wave index
-                _wave_index += inc;
-
-                // Have we reached the start of the wavetable?
-                if (_wave_index >= (_num_waves << 1)) {
-                    // Reached the start of the waves, switch to forward parsing
-                    _wave_index = 0;
-                    _samples = _file.samples[0].data();
-                    _parse_fwd = true;
-                    _wavetable_time = 0;              
-                }
-                else {
-                    // Decrement the samples pointer (also check for underflow)
-                    _samples -= ((inc + 1) * WAVE_LENGTH);
-                    if (_samples < _file.samples[0].data()) {
-                        _samples = _file.samples[0].data();
-                    }
-                }
-            }
+    float prev = wave[0];
+
+    // Compute the min/max of each bucket, and output them as two vertices per
+    // column. The vertex closest to the previous vertex is output first so
+    // that the envelope can be drawn as a continuous line
+    for (uint i=0; i<NUM_ENVELOPE_COLUMNS; i++) {
+        float min;
+        float max;
+        _bucket_min_max(wave, min, max);
+        if (std::fabs(min - prev) <= std::fabs(max - prev)) {
+            *envelope++ = min;
+            *envelope++ = max;
+            prev = max;
         }
-        
+        else {
+            *envelope++ = max;
+            *envelope++ = min;
+            prev = min;
+        }
+        wave += ENVELOPE_BUCKET_SIZE;
+    }
+}
+
+//----------------------------------------------------------------------------
+// _bucket_min_max
+//----------------------------------------------------------------------------
+void WtFile::_bucket_min_max(const float *samples, float& min, float& max)
+{
+#if defined(__ARM_NEON)
+    // NEON
+    float32x4_t vmin = vld1q_f32(samples);
+    float32x4_t vmax = vmin;
+    for (uint i=4; i<ENVELOPE_BUCKET_SIZE; i+=4) {
+        float32x4_t v = vld1q_f32(samples + i);
+        vmin = vminq_f32(vmin, v);
+        vmax = vmaxq_f32(vmax, v);
+    }
+#if defined(__aarch64__)
+    min = vminvq_f32(vmin);
+    max = vmaxvq_f32(vmax);
+#else
+    float32x2_t pmin = vpmin_f32(vget_low_f32(vmin), vget_high_f32(vmin));
+    float32x2_t pmax = vpmax_f32(vget_low_f32(vmax), vget_high_f32(vmax));
+    min = vget_lane_f32(vpmin_f32(pmin, pmin), 0);
+    max = vget_lane_f32(vpmax_f32(pmax, pmax), 0);
+#endif
+#elif defined(__SSE__)
+    // SSE
+    __m128 vmin = _mm_loadu_ps(samples);
+    __m128 vmax = vmin;
+    for (uint i=4; i<ENVELOPE_BUCKET_SIZE; i+=4) {
+        __m128 v = _mm_loadu_ps(samples + i);
+        vmin = _mm_min_ps(vmin, v);
+        vmax = _mm_max_ps(vmax, v);
+    }
+    vmin = _mm_min_ps(vmin, _mm_movehl_ps(vmin, vmin));
+    vmax = _mm_max_ps(vmax, _mm_movehl_ps(vmax, vmax));
+    min = _mm_cvtss_f32(_mm_min_ss(vmin, _mm_shuffle_ps(vmin, vmin, 1)));
+    max = _mm_cvtss_f32(_mm_max_ss(vmax, _mm_shuffle_ps(vmax, vmax, 1)));
+#else
+    // Scalar fallback
+    min = samples[0];
+    max = samples[0];
+    for (uint i=1; i<ENVELOPE_BUCKET_SIZE; i++) {
+        min = std::min(min, samples[i]);
+        max = std::max(max, samples[i]);
     }
-    return samples;
+#endif
 }
@@ -10,8 +10,18 @@
 #define _WT_FILE_H
 
 #include <cmath>
-#include <mutex>
-#include "AudioFile.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+// WT Table - the decimated waves of a loaded wavetable, which are never
+// modified once the table has been published
+struct WtTable
+{
+    uint num_waves;
+    std::vector<float> samples;
+};
 
 // WT File class
 class WtFile
@@ -19,6 +29,7 @@ class WtFile
 public:
     // Helper functions
     static uint NumSamplesPerWave();
+    static uint MaxNumWaves();
 
     // Constructor
     WtFile();
@@ -29,19 +40,18 @@ public:
     // Public functions
     bool load(std::string filename);
     void unload();
-    std::vector<float> next_wave_samples();
+    std::shared_ptr<const WtTable> table() const;
+    bool next_morph_pos(float& morph_pos);
 
 private:
     // Private data
-    std::mutex _mutex;
-    AudioFile<float> _file;
-    bool _loaded;
-    uint _num_waves;
-    uint _wave_index;
-    bool _parse_fwd;
-    const float *_samples;
-    float _wave_time;
+    std::shared_ptr<const WtTable> _table;
+    std::shared_ptr<const WtTable> _current_table;
     float _wavetable_time;
+
+    // Private functions
+    void _decimate_wave(const float *wave, float *envelope);
+    void _bucket_min_max(const float *samples, float& min, float& max);
 };
 
 #endif  // _WT_FILE_H
@@ -6,16 +6,124 @@
  * @brief Wavetable Scope class implementation.
  *-----------------------------------------------------------------------------
  */
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
 #include "wt_scope.h"
 #include "wt_file.h"
 #include "gui_common.h"
 #include "utils.h"
 
+// Constants
+// Each waterfall vertex is (x, y, wave index, visible), and each wave is
+// preceded by an invisible copy of its first vertex so that all waves can be
+// drawn as a single line strip
+constexpr uint WATERFALL_VERTEX_SIZE = 4;
+static inline uint _waterfall_vertices_per_wave() { return 1 + WtFile::NumSamplesPerWave(); }
+
+// Morph vertex shader
+// The decimated table is held in a texture with one wave per row, and each
+// vertex is generated from its ID - the min/max envelopes of the two waves
+// either side of the morph position are blended, keeping the vertex order of
+// the nearest wave so the line zig-zags correctly
+static const char *_morph_vertex_shader_source_core =
+    "#version 310 es\n"
+        "uniform highp sampler2D wave_table;\n"
+        "uniform float num_waves;\n"
+        "uniform float morph_pos;\n"
+        "void main()\n"
+        "{\n"
+        "   int column = gl_VertexID >> 1;\n"
+        "   int num_columns = textureSize(wave_table, 0).x >> 1;\n"
+        "   int wave = int(floor(morph_pos));\n"
+        "   int next_wave = min(wave + 1, int(num_waves) - 1);\n"
+        "   float blend = morph_pos - float(wave);\n"
+        "   vec2 a = vec2(texelFetch(wave_table, ivec2(column * 2, wave), 0).r,\n"
+        "                 texelFetch(wave_table, ivec2((column * 2) + 1, wave), 0).r);\n"
+        "   vec2 b = vec2(texelFetch(wave_table, ivec2(column * 2, next_wave), 0).r,\n"
+        "                 texelFetch(wave_table, ivec2((column * 2) + 1, next_wave), 0).r);\n"
+        "   vec2 env = mix(vec2(min(a.x, a.y), max(a.x, a.y)), vec2(min(b.x, b.y), max(b.x, b.y)), blend);\n"
+        "   vec2 order = (blend < 0.5) ? a : b;\n"
+        "   bool first_is_min = (order.x <= order.y);\n"
+        "   bool is_min = (((gl_VertexID & 1) == 0) == first_is_min);\n"
+        "   float x = -1.0 + ((float(column) / float(num_columns)) * 2.0);\n"
+        "   gl_Position = vec4(x, (is_min ? env.x : env.y), 0.0, 1.0);\n"
+        "}\0";
+
+// Morph fragment shader
+static const char *_morph_fragment_shader_source_core =
+    "#version 310 es\n"
+        "precision mediump float;\n"
+        "out vec4 FragColor;\n"
+        "uniform vec4 system_colour;\n"
+        "void main()\n"
+        "{\n"
+        "   FragColor = system_colour;\n"
+        "}\0";
+
+// Waterfall vertex shader
+// The waves are stacked in perspective - the first wave is at the front, and
+// each subsequent wave is scaled down and shifted up and to the right
+static const char *_waterfall_vertex_shader_source_core =
+    "#version 310 es\n"
+        "layout (location = 0) in vec4 aPos;\n"
+        "uniform float num_waves;\n"
+        "flat out float v_visible;\n"
+        "out float v_wave;\n"
+        "void main()\n"
+        "{\n"
+        "   float depth = aPos.z / max(num_waves - 1.0, 1.0);\n"
+        "   float scale = 1.0 - (0.4 * depth);\n"
+        "   float x = (aPos.x * scale * 0.85) + ((depth - 0.5) * 0.3);\n"
+        "   float y = (aPos.y * scale * 0.35) + ((depth - 0.5) * 1.2);\n"
+        "   v_visible = aPos.w;\n"
+        "   v_wave = aPos.z;\n"
+        "   gl_Position = vec4(x, y, 0.0, 1.0);\n"
+        "}\0";
+
+// Waterfall fragment shader
+// The waves either side of the morph position are drawn at full intensity,
+// and the other waves are dimmed with depth
+static const char *_waterfall_fragment_shader_source_core =
+    "#version 310 es\n"
+        "precision mediump float;\n"
+        "flat in float v_visible;\n"
+        "in float v_wave;\n"
+        "out vec4 FragColor;\n"
+        "uniform vec4 system_colour;\n"
+        "uniform float num_waves;\n"
+        "uniform float wave_pos;\n"
+        "void main()\n"
+        "{\n"
+        "   if (v_visible < 0.5)\n"
+        "       discard;\n"
+        "   float depth = v_wave / max(num_waves - 1.0, 1.0);\n"
+        "   float highlight = clamp(1.0 - abs(v_wave - wave_pos), 0.0, 1.0);\n"
+        "   float alpha = mix(0.6 - (0.4 * depth), 1.0, highlight);\n"
+        "   FragColor = vec4(system_colour.rgb, system_colour.a * alpha);\n"
+        "}\0";
+
 //----------------------------------------------------------------------------
 // WtScope
 //----------------------------------------------------------------------------
 WtScope::WtScope(QWidget *parent) : Scope(WtFile::NumSamplesPerWave(), parent)
 {
+    // Initialise the GL data - the waterfall vertices are only allocated if
+    // the waterfall mode is selected
+    _mode = WtScopeMode::SINGLE_WAVE;
+    _morph_program = nullptr;
+    _morph_texture = 0;
+    _morph_colour_loc = -1;
+    _morph_num_waves_loc = -1;
+    _morph_pos_loc = -1;
+    _num_waves = 0;
+    _morph_pos = 0.0f;
+    _morph_dirty = false;
+    _waterfall_program = nullptr;
+    _waterfall_colour_loc = -1;
+    _waterfall_num_waves_loc = -1;
+    _waterfall_wave_pos_loc = -1;
+    _waterfall_dirty = false;
+
     // Create the WT chart timer
     _wt_timer = new QTimer(this);
     connect(_wt_timer, &QTimer::timeout, this, &WtScope::update_scope);
@@ -30,7 +138,31 @@ WtScope::WtScope(QWidget *parent) : Scope(WtFile::NumSamplesPerWave(), parent)
 //----------------------------------------------------------------------------
 WtScope::~WtScope()
 {
-    // Nothing specific to do
+    // Perform any WT cleanup actions
+    cleanup_wt();
+}
+
+//----------------------------------------------------------------------------
+// set_mode
+//----------------------------------------------------------------------------
+void WtScope::set_mode(WtScopeMode mode)
+{
+    // Has the mode changed?
+    if (mode != _mode) {
+        _mode = mode;
+        if (_mode == WtScopeMode::WATERFALL) {
+            // Allocate the waterfall vertices for the largest possible table,
+            // and build them from any loaded table
+            _waterfall_vertices.resize(WtFile::MaxNumWaves() * _waterfall_vertices_per_wave() * WATERFALL_VERTEX_SIZE);
+            _load_table();
+        }
+        else {
+            // Release the waterfall vertices
+            std::vector<float>().swap(_waterfall_vertices);
+            _waterfall_dirty = false;
+        }
+        update();
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -43,11 +175,13 @@ void WtScope::load_wt_file(const std::string& file)
 
     // Load the WT file
     if (_wt_file.load(file)) {
-        // Start the WT timer and show the WT chart
+        // Prepare the table for upload, start the WT timer and show the WT chart
+        _load_table();
         _wt_timer->start(WT_CHART_REFRESH_RATE);
     }
     else {
         // The WT file could not be loaded, so just display a line at 0.0
+        _num_waves = 0;
         show_zero_scope();
     }
 }
@@ -60,6 +194,7 @@ void WtScope::unload_wt_file()
     // Stop the WT timer and unload the file
     _wt_timer->stop();
     _wt_file.unload();
+    _num_waves = 0;
     clear_scope();
 }
 
@@ -68,19 +203,12 @@ void WtScope::unload_wt_file()
 //----------------------------------------------------------------------------
 void WtScope::update_scope()
 {
-    QVector<QPointF> data;
-
-    // Get the next wave samples to display
-    auto samples = _wt_file.next_wave_samples();
-    if (samples.size() > 0) {
-        // Add the points to the data
-        for (uint i=0; i<samples.size(); i++) {
-            auto x = -1.0f + ((qreal(i) / samples.size()) * 2);
-            data.append(QPointF(x, samples[i]));
-        }
-
-        // Refresh the scope
-        refresh_data(data);
+    // Get the next morph position - the whole table is already in the GPU,
+    // so this is the only data that changes each frame
+    float morph_pos;
+    if (_wt_file.next_morph_pos(morph_pos)) {
+        _morph_pos = morph_pos;
+        update();
     }
 }
 
@@ -92,3 +220,227 @@ void WtScope::refresh_colour()
     // Refresh the scope colour
     set_colour(utils::get_system_colour());
 }
+
+//----------------------------------------------------------------------------
+// cleanup_wt
+//----------------------------------------------------------------------------
+void WtScope::cleanup_wt()
+{
+    // If the WT shader programs are defined
+    if (_morph_program) {
+        // Clean up the shader programs, texture and vertex objects
+        makeCurrent();
+        glDeleteTextures(1, &_morph_texture);
+        _morph_texture = 0;
+        _morph_vao.destroy();
+        _waterfall_vao.destroy();
+        _waterfall_vbo.destroy();
+        delete _morph_program;
+        _morph_program = nullptr;
+        delete _waterfall_program;
+        _waterfall_program = nullptr;
+        doneCurrent();
+        QObject::disconnect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &WtScope::cleanup_wt);
+    }
+}
+
+//----------------------------------------------------------------------------
+// initializeGL
+//----------------------------------------------------------------------------
+void WtScope::initializeGL()
+{
+    // Initialise the base scope (used when no table is loaded)
+    Scope::initializeGL();
+
+    // Make sure we handle any Open GL clean-up correctly
+    connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &WtScope::cleanup_wt);
+
+    // Create the morph shader program
+    _morph_program = new QOpenGLShaderProgram;
+    _morph_program->addShaderFromSourceCode(QOpenGLShader::Vertex, _morph_vertex_shader_source_core);
+    _morph_program->addShaderFromSourceCode(QOpenGLShader::Fragment, _morph_fragment_shader_source_core);
+    _morph_program->link();
+    _morph_program->bind();
+    _morph_program->setUniformValue("wave_table", 0);
+    _morph_colour_loc = _morph_program->uniformLocation("system_colour");
+    _morph_num_waves_loc = _morph_program->uniformLocation("num_waves");
+    _morph_pos_loc = _morph_program->uniformLocation("morph_pos");
+    _morph_program->release();
+
+    // The morph vertices are generated in the shader, so it uses an empty VAO
+    _morph_vao.create();
+
+    // Create the morph texture - this is allocated once for the largest
+    // possible table, with one row per wave, and is only written when a
+    // table is loaded
+    QOpenGLExtraFunctions *ef = QOpenGLContext::currentContext()->extraFunctions();
+    ef->glGenTextures(1, &_morph_texture);
+    ef->glBindTexture(GL_TEXTURE_2D, _morph_texture);
+    ef->glTexStorage2D(GL_TEXTURE_2D, 1, GL_R32F, WtFile::NumSamplesPerWave(), WtFile::MaxNumWaves());
+    ef->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    ef->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    ef->glBindTexture(GL_TEXTURE_2D, 0);
+
+    // Create the waterfall shader program
+    _waterfall_program = new QOpenGLShaderProgram;
+    _waterfall_program->addShaderFromSourceCode(QOpenGLShader::Vertex, _waterfall_vertex_shader_source_core);
+    _waterfall_program->addShaderFromSourceCode(QOpenGLShader::Fragment, _waterfall_fragment_shader_source_core);
+    _waterfall_program->bindAttributeLocation("vertex", 0);
+    _waterfall_program->link();
+    _waterfall_program->bind();
+    _waterfall_colour_loc = _waterfall_program->uniformLocation("system_colour");
+    _waterfall_num_waves_loc = _waterfall_program->uniformLocation("num_waves");
+    _waterfall_wave_pos_loc = _waterfall_program->uniformLocation("wave_pos");
+
+    // Create the waterfall VAO and VBO - the VBO is allocated once for the
+    // largest possible table, and is only written when a table is loaded
+    _waterfall_vao.create();
+    QOpenGLVertexArrayObject::Binder vao_binder(&_waterfall_vao);
+    QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
+    _waterfall_vbo.create();
+    _waterfall_vbo.bind();
+    _waterfall_vbo.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    _waterfall_vbo.allocate((WtFile::MaxNumWaves() * _waterfall_vertices_per_wave() * WATERFALL_VERTEX_SIZE) * sizeof(GLfloat));
+    f->glVertexAttribPointer(0, WATERFALL_VERTEX_SIZE, GL_FLOAT, GL_FALSE, WATERFALL_VERTEX_SIZE * sizeof(GLfloat),
+                             nullptr);
+    f->glEnableVertexAttribArray(0);
+    _waterfall_vbo.release();
+    _waterfall_program->release();
+
+    // Make sure any already loaded table is uploaded
+    _morph_dirty = (_num_waves > 0);
+    _waterfall_dirty = (_num_waves > 0) && (_mode == WtScopeMode::WATERFALL);
+}
+
+//----------------------------------------------------------------------------
+// paintGL
+//----------------------------------------------------------------------------
+void WtScope::paintGL()
+{
+    // If there is no table loaded, draw the base scope
+    if ((_num_waves == 0) || (_morph_program == nullptr)) {
+        Scope::paintGL();
+        return;
+    }
+
+    // Clear the scope and draw the table in the current mode
+    glClear(GL_COLOR_BUFFER_BIT);
+    if (_mode == WtScopeMode::WATERFALL) {
+        _paint_waterfall();
+    }
+    else {
+        _paint_morph();
+    }
+}
+
+//----------------------------------------------------------------------------
+// _load_table
+//----------------------------------------------------------------------------
+void WtScope::_load_table()
+{
+    // Get the loaded table, if any
+    auto table = _wt_file.table();
+    _num_waves = 0;
+    if (!table || (table->num_waves == 0)) {
+        return;
+    }
+
+    // The table is uploaded to the GPU on the next paint
+    _num_waves = table->num_waves;
+    _morph_pos = 0.0f;
+    _morph_dirty = true;
+    if (_mode == WtScopeMode::WATERFALL) {
+        _build_waterfall(*table);
+    }
+    update();
+}
+
+//----------------------------------------------------------------------------
+// _build_waterfall
+//----------------------------------------------------------------------------
+void WtScope::_build_waterfall(const WtTable& table)
+{
+    // Build the vertices for each wave - the waves are ordered back to front so
+    // that the front waves are drawn over the back waves
+    // Note: Both vertices of each min/max envelope column share the same x
+    uint num_columns = WtFile::NumSamplesPerWave() >> 1;
+    float *v = _waterfall_vertices.data();
+    for (uint s=0; s<table.num_waves; s++) {
+        uint wave = table.num_waves - 1 - s;
+        const float *samples = table.samples.data() + (wave * WtFile::NumSamplesPerWave());
+
+        // Add the invisible bridge vertex, followed by the wave envelope
+        *v++ = -1.0f;
+        *v++ = samples[0];
+        *v++ = wave;
+        *v++ = 0.0f;
+        for (uint i=0; i<WtFile::NumSamplesPerWave(); i++) {
+            *v++ = -1.0f + ((float(i >> 1) / num_columns) * 2);
+            *v++ = samples[i];
+            *v++ = wave;
+            *v++ = 1.0f;
+        }
+    }
+    _waterfall_dirty = true;
+}
+
+//----------------------------------------------------------------------------
+// _paint_morph
+//----------------------------------------------------------------------------
+void WtScope::_paint_morph()
+{
+    QOpenGLExtraFunctions *ef = QOpenGLContext::currentContext()->extraFunctions();
+    QOpenGLVertexArrayObject::Binder vao_binder(&_morph_vao);
+
+    // Upload the table to the morph texture if a new table has been loaded
+    ef->glActiveTexture(GL_TEXTURE0);
+    ef->glBindTexture(GL_TEXTURE_2D, _morph_texture);
+    if (_morph_dirty) {
+        auto table = _wt_file.table();
+        if (table) {
+            ef->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, WtFile::NumSamplesPerWave(), table->num_waves,
+                                GL_RED, GL_FLOAT, table->samples.data());
+        }
+        _morph_dirty = false;
+    }
+
+    // Draw the wave blended at the morph position - only the uniforms change
+    // per frame
+    auto c = colour();
+    _morph_program->bind();
+    _morph_program->setUniformValue(_morph_colour_loc, QVector4D(c.redF(), c.greenF(), c.blueF(), alpha()));
+    _morph_program->setUniformValue(_morph_num_waves_loc, (GLfloat)_num_waves);
+    _morph_program->setUniformValue(_morph_pos_loc, _morph_pos);
+    ef->glLineWidth(pen_width());
+    ef->glDrawArrays(GL_LINE_STRIP, 0, WtFile::NumSamplesPerWave());
+    _morph_program->release();
+    ef->glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+//----------------------------------------------------------------------------
+// _paint_waterfall
+//----------------------------------------------------------------------------
+void WtScope::_paint_waterfall()
+{
+    QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
+    QOpenGLVertexArrayObject::Binder vao_binder(&_waterfall_vao);
+
+    // Upload the waterfall vertices if a new table has been loaded
+    _waterfall_program->bind();
+    if (_waterfall_dirty) {
+        _waterfall_vbo.bind();
+        _waterfall_vbo.write(0, _waterfall_vertices.data(),
+                             (_num_waves * _waterfall_vertices_per_wave() * WATERFALL_VERTEX_SIZE) * sizeof(GLfloat));
+        _waterfall_vbo.release();
+        _waterfall_dirty = false;
+    }
+
+    // Draw all waves in a single call - only the uniforms change per frame
+    auto c = colour();
+    _waterfall_program->setUniformValue(_waterfall_colour_loc, QVector4D(c.redF(), c.greenF(), c.blueF(), alpha()));
+    _waterfall_program->setUniformValue(_waterfall_num_waves_loc, (GLfloat)_num_waves);
+    _waterfall_program->setUniformValue(_waterfall_wave_pos_loc, _morph_pos);
+    f->glLineWidth(pen_width());
+    glDrawArrays(GL_LINE_STRIP, 0, _num_waves * _waterfall_vertices_per_wave());
+    _waterfall_program->release();
+}
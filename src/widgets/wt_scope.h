@@ -9,10 +9,18 @@
 #ifndef WT_SCOPE_H
 #define WT_SCOPE_H
 
+#include <vector>
 #include <QTimer>
 #include "scope.h"
 #include "wt_file.h"
 
+// Wavetable Scope Mode
+enum class WtScopeMode
+{
+	SINGLE_WAVE,
+	WATERFALL
+};
+
 // Wavetable Scope class
 class WtScope : public Scope
 {
@@ -23,15 +31,49 @@ public:
 	~WtScope();
 
 	// Public functions
+	void set_mode(WtScopeMode mode);
 	void load_wt_file(const std::string& file);
 	void unload_wt_file();
 	void update_scope();
 	void refresh_colour();
 
+public slots:
+	// Public slot functions
+	void cleanup_wt();
+
+protected:
+	// Protected functions
+	void initializeGL() override;
+	void paintGL() override;
+
 private:
 	// Private data
 	WtFile _wt_file;
 	QTimer *_wt_timer;
+	WtScopeMode _mode;
+	QOpenGLVertexArrayObject _morph_vao;
+	QOpenGLShaderProgram *_morph_program;
+	GLuint _morph_texture;
+	int _morph_colour_loc;
+	int _morph_num_waves_loc;
+	int _morph_pos_loc;
+	uint _num_waves;
+	float _morph_pos;
+	bool _morph_dirty;
+	QOpenGLVertexArrayObject _waterfall_vao;
+	QOpenGLBuffer _waterfall_vbo;
+	QOpenGLShaderProgram *_waterfall_program;
+	int _waterfall_colour_loc;
+	int _waterfall_num_waves_loc;
+	int _waterfall_wave_pos_loc;
+	std::vector<float> _waterfall_vertices;
+	bool _waterfall_dirty;
+
+	// Private functions
+	void _load_table();
+	void _build_waterfall(const WtTable& table);
+	void _paint_morph();
+	void _paint_waterfall();
 };
 
 #endif